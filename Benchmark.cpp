@@ -0,0 +1,235 @@
+/*
+ * File: Benchmark.cpp
+ * Project: TVJ_Tree
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/14 (tested on MSVC and MinGW)
+ *
+ * @version 1.0 2026/10/18
+ * - traversal of a compact_binary_tree by one thread and by several threads sharing the work in work_stealing_deque
+ * - concurrent_stack against a stack guarded by a mutex
+ *
+ */
+
+// Build it with optimization (e.g. -O2) and run it with the number of threads as the argument
+// (the hardware concurrency by default).
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "TVJ_Compact_Binary_Tree.h"
+#include "TVJ_Concurrent_Stack.h"
+#include "TVJ_Work_Stealing_Deque.h"
+#include "TVJ_Stack.h"
+using namespace tvj;
+
+#define BENCHMARK_NODES (1 << 22)      // the number of nodes of the tree
+#define BENCHMARK_OPERATIONS (1 << 20) // the number of pushes (and pops) of each thread
+#define BENCHMARK_PUBLISH 1024         // a worker adds its count to the shared one after this many nodes
+
+// a compact_binary_tree that also shows the links by the indices,
+// so a frontier holds 32-bit indices which a work_stealing_deque moves without a lock
+class tree_type : public compact_binary_tree<long long>
+{
+public:
+	uint32_t root_index() const noexcept { return _link(0).L_child_; }
+	uint32_t left_of(uint32_t node) const noexcept { return _link(node).L_child_; }
+	uint32_t right_of(uint32_t node) const noexcept { return _link(node).R_child_; }
+	long long value_of(uint32_t node) const noexcept { return _data(node); }
+};
+
+// the milliseconds since a time point
+inline double elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// a random tree, each new node is the child of a random node that still has room
+inline void grow_random(tree_type& tree, size_t size)
+{
+	tree.reserve(size);
+	std::vector<tree_type::iterator> open__;
+	open__.push_back(tree.set_root(0));
+	srand(2021);
+	for (long long value__ = 1; tree.size() != size; value__++)
+	{
+		const size_t pick__ = (static_cast<size_t>(rand()) * (static_cast<size_t>(RAND_MAX) + 1) + rand()) % open__.size();
+		tree_type::iterator node__ = open__[pick__];
+		const bool left__ = node__.has_left_child() ? false : node__.has_right_child() ? true : rand() % 2;
+		if (left__) node__.set_left_child(value__);
+		else node__.set_right_child(value__);
+		open__.push_back(left__ ? node__.left_child() : node__.right_child());
+		if (node__.has_left_child() && node__.has_right_child())
+		{
+			open__[pick__] = open__.back();
+			open__.pop_back();
+		}
+	}
+}
+
+// the sum of all values, walking the links in inorder
+inline long long sum_by_links(const tree_type& tree)
+{
+	long long sum__ = 0;
+	const tree_type::const_iterator end__ = tree.cend();
+	for (tree_type::const_iterator iter__ = tree.cbegin(); iter__ != end__; ++iter__) sum__ += *iter__;
+	return sum__;
+}
+
+// the sum of all values, visiting the nodes from a stack (the sequential form of the parallel one)
+inline long long sum_by_stack(const tree_type& tree)
+{
+	long long sum__ = 0;
+	segmented_stack<uint32_t> frontier__;
+	frontier__.push(tree.root_index());
+	while (!frontier__.empty())
+	{
+		const uint32_t node__ = frontier__.pop();
+		sum__ += tree.value_of(node__);
+		if (tree.right_of(node__) != COMPACT_BT_NIL) frontier__.push(tree.right_of(node__));
+		if (tree.left_of(node__) != COMPACT_BT_NIL) frontier__.push(tree.left_of(node__));
+	}
+	return sum__;
+}
+
+struct traversal_state
+{
+	const tree_type* tree_;
+	work_stealing_deque<uint32_t>* frontiers_; // one for each worker
+	unsigned workers_;
+	std::atomic<size_t> visited_;
+	std::atomic<long long> sum_;
+};
+
+// visit the nodes of its own frontier, and steal from the others when it is empty
+inline void traversal_worker(traversal_state* state, unsigned worker)
+{
+	const tree_type& tree__ = *state->tree_;
+	work_stealing_deque<uint32_t>& own__ = state->frontiers_[worker];
+	const size_t size__ = tree__.size();
+	long long sum__ = 0;
+	size_t visited__ = 0;
+	unsigned victim__ = worker;
+	uint32_t node__;
+	while (state->visited_.load(std::memory_order_acquire) != size__)
+	{
+		bool found__ = own__.pop(node__);
+		for (unsigned k = 1; !found__ && k < state->workers_; k++)
+		{
+			victim__ = (victim__ + 1) % state->workers_;
+			if (victim__ != worker) found__ = state->frontiers_[victim__].steal(node__);
+		}
+		if (!found__)
+		{
+			if (visited__)
+			{
+				state->visited_.fetch_add(visited__, std::memory_order_release);
+				visited__ = 0;
+			}
+			std::this_thread::yield();
+			continue;
+		}
+		sum__ += tree__.value_of(node__);
+		if (tree__.right_of(node__) != COMPACT_BT_NIL) own__.push(tree__.right_of(node__));
+		if (tree__.left_of(node__) != COMPACT_BT_NIL) own__.push(tree__.left_of(node__));
+		if (++visited__ == BENCHMARK_PUBLISH)
+		{
+			state->visited_.fetch_add(visited__, std::memory_order_release);
+			visited__ = 0;
+		}
+	}
+	state->sum_.fetch_add(sum__);
+}
+
+// the sum of all values, visited by several threads
+inline long long sum_in_parallel(const tree_type& tree, unsigned workers)
+{
+	traversal_state state__;
+	state__.tree_ = &tree;
+	state__.frontiers_ = new work_stealing_deque<uint32_t>[workers];
+	state__.workers_ = workers;
+	state__.visited_ = 0;
+	state__.sum_ = 0;
+	state__.frontiers_[0].push(tree.root_index());
+	std::thread* threads__ = new std::thread[workers - 1];
+	for (unsigned k = 1; k != workers; k++) threads__[k - 1] = std::thread(traversal_worker, &state__, k);
+	traversal_worker(&state__, 0);
+	for (unsigned k = 1; k != workers; k++) threads__[k - 1].join();
+	delete[] threads__;
+	delete[] state__.frontiers_;
+	return state__.sum_;
+}
+
+inline void concurrent_stack_worker(concurrent_stack<long long>* stack, std::atomic<long long>* sum)
+{
+	long long sum__ = 0, value__;
+	for (long long i = 0; i != BENCHMARK_OPERATIONS; i++)
+	{
+		stack->push(i);
+		if (stack->pop(value__)) sum__ += value__;
+	}
+	sum->fetch_add(sum__);
+}
+
+inline void locked_stack_worker(stack<long long>* stack, std::mutex* lock, std::atomic<long long>* sum)
+{
+	long long sum__ = 0;
+	for (long long i = 0; i != BENCHMARK_OPERATIONS; i++)
+	{
+		std::lock_guard<std::mutex> guard__(*lock);
+		stack->push(i);
+		if (!stack->empty()) sum__ += stack->pop();
+	}
+	sum->fetch_add(sum__);
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned workers = argc > 1 ? static_cast<unsigned>(atoi(argv[1])) : std::thread::hardware_concurrency();
+	if (workers == 0) workers = 1;
+	std::cout << "threads: " << workers << std::endl;
+
+	tree_type tree;
+	auto start = std::chrono::steady_clock::now();
+	grow_random(tree, BENCHMARK_NODES);
+	std::cout << "build a random tree of " << tree.size() << " nodes: " << elapsed_ms(start) << " ms" << std::endl;
+	const long long expected = static_cast<long long>(tree.size()) * (static_cast<long long>(tree.size()) - 1) / 2;
+
+	start = std::chrono::steady_clock::now();
+	long long sum = sum_by_links(tree);
+	std::cout << "inorder by the links:         " << elapsed_ms(start) << " ms" << (sum == expected ? "" : " (wrong sum)") << std::endl;
+
+	start = std::chrono::steady_clock::now();
+	sum = sum_by_stack(tree);
+	std::cout << "preorder from a stack:        " << elapsed_ms(start) << " ms" << (sum == expected ? "" : " (wrong sum)") << std::endl;
+
+	start = std::chrono::steady_clock::now();
+	sum = sum_in_parallel(tree, workers);
+	std::cout << "work-stealing frontiers:      " << elapsed_ms(start) << " ms" << (sum == expected ? "" : " (wrong sum)") << std::endl;
+
+	std::thread* threads = new std::thread[workers];
+	std::atomic<long long> total(0);
+	concurrent_stack<long long> shared_stack;
+	start = std::chrono::steady_clock::now();
+	for (unsigned k = 0; k != workers; k++) threads[k] = std::thread(concurrent_stack_worker, &shared_stack, &total);
+	for (unsigned k = 0; k != workers; k++) threads[k].join();
+	std::cout << "concurrent_stack push & pop:  " << elapsed_ms(start) << " ms" << std::endl;
+
+	stack<long long> locked_stack;
+	std::mutex lock;
+	start = std::chrono::steady_clock::now();
+	for (unsigned k = 0; k != workers; k++) threads[k] = std::thread(locked_stack_worker, &locked_stack, &lock, &total);
+	for (unsigned k = 0; k != workers; k++) threads[k].join();
+	std::cout << "stack with a mutex:           " << elapsed_ms(start) << " ms" << std::endl;
+	delete[] threads;
+
+	return 0;
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
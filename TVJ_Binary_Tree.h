@@ -5,8 +5,47 @@
  * @author: Teddy van Jerry
  * @licence: The MIT Licence
  * @compiler: at least C++/11 (tested on MSVC)
- * @reliance: TVJ_Vector.h 1.4, TVJ_Stack.h 1.0
+ * @reliance: TVJ_Vector.h 1.7, TVJ_Stack.h 1.2, TVJ_Node_Pool.h 1.2
  *
+ * @version 2.4 2026/10/18
+ * - build_from_level_order ignores the null markers after the last node
+ * 
+ * @version 2.3 2026/10/18
+ * - add the copy assignment (the node pool is not copied)
+ * - bug fix: copying an empty tree
+ * 
+ * @version 2.2 2026/10/18
+ * - at, preorder_at, postorder_at and remove_at throw std::out_of_range for an index not less than the size
+ * 
+ * @version 2.1 2026/10/18
+ * - add bulk builders: build_balanced, build_from_preorder, build_from_postorder and build_from_level_order (all O(n))
+ * 
+ * @version 2.0 2026/10/18
+ * - the nodes are allocated from a node_pool (owned by the tree or shared by several trees)
+ * - the destructor and _remove_node free the nodes
+ * 
+ * @version 1.9 2026/10/18
+ * - each node records its index in every sequence when the sequence is built, so finding it is O(1)
+ * 
+ * @version 1.8 2026/10/18
+ * - iterators step by the child and parent links in all three orders (amortized O(1), no sequence needed)
+ * - the end of the iterators is the parent of the root, so it stays valid after insertions
+ * 
+ * @version 1.7 2026/10/18
+ * - optional subtree sizes in the nodes (TVJ_BT_SUBTREE_SIZE) for positional access in O(height)
+ * - a node with children given in the constructor becomes their parent
+ * 
+ * @version 1.6 2026/10/18
+ * - the sequences are built lazily, a change only marks them out of date
+ * - iterators hold their node, so moving in the tree and adding children are O(1)
+ * - _remove_node splices the node (or its inorder predecessor) out and keeps the parent links
+ * 
+ * @version 1.5 2026/10/18
+ * - the traversals use segmented_stack, so a deep tree never copies the stack on growth
+ * 
+ * @version 1.4 2026/10/18
+ * - the postorder traversal retags the top of the stack in place
+ * 
  * @version 1.3 2021/05/27
  * - cater for AVL trees
  * - add function remove_at
@@ -28,11 +67,14 @@
 
 #include <stdexcept>
 #include <exception>
+#include <type_traits>
+#include <utility>
 #ifdef _MSC_VER
 #include <xutility> // std::_Is_iterator
 #endif // for MSVC
 #include "TVJ_Vector.h"
 #include "TVJ_Stack.h"
+#include "TVJ_Node_Pool.h"
 
  /* USED FOR TEST */
  // #include <iostream>
@@ -40,11 +82,13 @@
 namespace tvj
 {
 
-#define sequence_ _sequence_ptr_to_ref()
 #define cthis const_cast<const BT_ptr>(this)
 
 	constexpr size_t negative_1 = static_cast<size_t>(0) - 1;
 
+	// define TVJ_BT_SUBTREE_SIZE before including this file to keep the size of every subtree in its node,
+	// then at, iterator arithmetic and distance take O(height) and never build the sequences
+
 	template<typename Elem>
 	class binary_tree
 	{
@@ -57,6 +101,13 @@ namespace tvj
 			Elem data_;
 			BT_Node* parent_, * L_child_, * R_child_;
 			int weitht_ = 0;
+#ifdef TVJ_BT_SUBTREE_SIZE
+			// the number of nodes in the subtree rooted here (itself included)
+			size_t subtree_size_ = 1;
+#else
+			// the index in the sequence of each order (by Traversal_Order), set when that sequence is built
+			size_t position_[3];
+#endif
 		};
 
 		static vector<BT_Node*> empty_vector_for_sequence_init___;
@@ -68,30 +119,150 @@ namespace tvj
 		// BT_Node R_end_ = &root_parent_;
 		size_t size_ = 0;
 
+		// the pool of this tree, used unless a shared one is given to the constructor
+		node_pool<BT_Node> own_pool_;
+
+		// the pool that owns every node of the tree
+		node_pool<BT_Node>* pool_ = &own_pool_;
+
+		/**
+		 * brief: construct a node in the pool of the tree
+		 * param: the arguments of the constructor of BT_Node
+		 * return: the node
+		 */
+		template<typename... Args>
+		BT_Node* _new_node(Args&&... args);
+
+		/**
+		 * brief: free a subtree (without unlinking it from its parent)
+		 * param: its root (can be nullptr)
+		 * return: void
+		 */
+		void _destroy_subtree(BT_Node* node) noexcept;
+
+		/**
+		 * brief: free all the nodes and leave the tree empty
+		 * param: (void)
+		 * return: void
+		 */
+		void _clear() noexcept;
+
+		/**
+		 * brief: replace the tree by the one with a preorder (or postorder) sequence and an inorder sequence,
+		 *        by a stack in O(n) (the elements are supposed to be distinct)
+		 * param: the preorder (or postorder) sequence, the inorder sequence and whether the first one is in postorder
+		 * return: void
+		 */
+		void _build_from_sequences(const vector<Elem>& sequence, const vector<Elem>& inorder, bool is_postorder);
+
+#ifdef TVJ_BT_SUBTREE_SIZE
+		/**
+		 * brief: count the size of every subtree again, bottom up
+		 * param: (void)
+		 * return: void
+		 */
+		void _recount_subtree_sizes() noexcept;
+#endif
+
 	protected:
 
 		// a vector that stores the sequence of the binary tree in preorder
-		vector<BT_Node*> sequence_pre_;
+		mutable vector<BT_Node*> sequence_pre_;
 
 		// a vector that stores the sequence of the binary tree in inorder
-		vector<BT_Node*> sequence_in_;
+		mutable vector<BT_Node*> sequence_in_;
 
 		// a vector that stores the sequence of the binary tree in postorder
-		vector<BT_Node*> sequence_post_;
+		mutable vector<BT_Node*> sequence_post_;
 
 		enum Traversal_Order { PREORDER, INORDER, POSTORDER };
 
-		void _preorder_update() noexcept;
-
-		void _inorder_update() noexcept;
-
-		void _postorder_update() noexcept;
-
-		bool preorder_update = true, inorder_updated = true, postorder_updated = true;
+		void _preorder_update() const noexcept;
+
+		void _inorder_update() const noexcept;
+
+		void _postorder_update() const noexcept;
+
+		// whether each sequence matches the tree,
+		// a change only clears them and a sequence is rebuilt when it is next used
+		mutable bool preorder_updated = true, inorder_updated = true, postorder_updated = true;
+
+		/**
+		 * brief: mark all the sequences out of date after the tree changes
+		 * param: (void)
+		 * return: void
+		 */
+		void _invalidate_sequences() noexcept;
+
+		/**
+		 * brief: the sequence in a certain order, rebuilt first if it is out of date
+		 * param: the order
+		 * return: the sequence
+		 */
+		vector<BT_Node*>& _sequence(Traversal_Order order) const noexcept;
+
+		/**
+		 * brief: the node at an index of the sequence in a certain order
+		 *        (O(height) by the subtree sizes if TVJ_BT_SUBTREE_SIZE is defined)
+		 * param: the order and the index (std::out_of_range is thrown if it is not less than the size)
+		 * return: BT_Node*
+		 */
+		BT_Node* _node_at(Traversal_Order order, size_t index) const;
+
+		/**
+		 * brief: the index of a node in the sequence in a certain order
+		 *        (O(height) by the subtree sizes if TVJ_BT_SUBTREE_SIZE is defined,
+		 *        otherwise O(1) by the position recorded in the node once the sequence is built)
+		 * param: the order and the node
+		 * return: the index, the size indicating it is not in the tree
+		 */
+		size_t _index_of(Traversal_Order order, const BT_Node* node) const noexcept;
+
+		/**
+		 * brief: the first node in a certain order
+		 * param: the order
+		 * return: BT_Node*, the parent of the root (the end) if the tree is empty
+		 */
+		BT_Node* _first(Traversal_Order order) const noexcept;
+
+		/**
+		 * brief: the node after another in a certain order, by the child and parent links
+		 * param: the order and the node (the end stays the end)
+		 * return: BT_Node*, the parent of the root (the end) after the last one
+		 */
+		BT_Node* _next(Traversal_Order order, BT_Node* node) const noexcept;
+
+		/**
+		 * brief: the node before another in a certain order, by the child and parent links
+		 * param: the order and the node (the parent of the root for the last one)
+		 * return: BT_Node*, nullptr before the first one
+		 */
+		BT_Node* _previous(Traversal_Order order, BT_Node* node) const noexcept;
+
+#ifdef TVJ_BT_SUBTREE_SIZE
+		/**
+		 * brief: the size of a subtree
+		 * param: its root (can be nullptr)
+		 * return: size_t
+		 */
+		static size_t _subtree_size(const BT_Node* node) noexcept;
+
+		/**
+		 * brief: add or remove one node in the sizes of a subtree and all above it
+		 * param: the root of the subtree and whether a node is added
+		 * return: void
+		 */
+		void _update_subtree_sizes(BT_Node* node, bool grow) noexcept;
+#endif
 
 	public:
 
-		void update_sequence(Traversal_Order order = INORDER);
+		/**
+		 * brief: build the sequence in a certain order now (otherwise it is built when first used)
+		 * param: the order
+		 * return: void
+		 */
+		void update_sequence(Traversal_Order order = INORDER) const noexcept;
 
 	public:
 		class inorder_const_iterator
@@ -122,6 +293,10 @@ namespace tvj
 
 			inorder_const_iterator(const BT_ptr& tree, BT_Node* node);
 
+			inorder_const_iterator(const BT_ptr& tree, Traversal_Order order, size_t index);
+
+			inorder_const_iterator(const BT_ptr& tree, Traversal_Order order, BT_Node* node);
+
 		public:
 			// @ functions providing limited access
 			const Elem& operator* () const;
@@ -161,13 +336,37 @@ namespace tvj
 		protected:
 			size_t _find_node_index(BT_Node* node) const noexcept;
 
-		protected:
-			vector<BT_Node*>* sequence_ptr_;
-			size_t index_ = 0;
-			BT_ptr parent_tree_ = nullptr;
+			/**
+			 * brief: the index in the sequence, found again if the tree has changed since it was known
+			 * param: (void)
+			 * return: size_t
+			 */
+			size_t _index() const noexcept;
+
+			/**
+			 * brief: move to an index of the sequence
+			 * param: the index
+			 * return: void
+			 */
+			void _move_to(size_t index) noexcept;
+
+			/**
+			 * brief: move to the next or the previous node by the links
+			 * param: whether to move forward
+			 * return: void
+			 */
+			void _step(bool forward) noexcept;
 
 		protected:
-			vector<BT_Node*>& _sequence_ptr_to_ref() const noexcept;
+			Traversal_Order order_ = INORDER;
+
+			// the node, the parent of the root at the end and nullptr before the beginning
+			BT_Node* node_ = nullptr;
+
+			// the index of node_ in the sequence, which may be out of date after a change
+			mutable size_t index_ = 0;
+
+			BT_ptr parent_tree_ = nullptr;
 		};
 
 		class inorder_iterator : public inorder_const_iterator
@@ -195,6 +394,10 @@ namespace tvj
 
 			inorder_iterator(BT_ptr tree, BT_Node* node);
 
+			inorder_iterator(BT_ptr tree, Traversal_Order order, size_t index);
+
+			inorder_iterator(BT_ptr tree, Traversal_Order order, BT_Node* node);
+
 		public:
 
 			// @limited access
@@ -240,6 +443,7 @@ namespace tvj
 
 		class preorder_iterator : public inorder_iterator
 		{
+			friend class binary_tree<Elem>;
 		public:
 			// constructor
 			preorder_iterator(binary_tree* tree);
@@ -271,6 +475,9 @@ namespace tvj
 
 		class postorder_iterator : public inorder_iterator
 		{
+			friend class binary_tree<Elem>;
+		public:
+			// constructor
 			postorder_iterator(binary_tree* tree);
 
 		protected:
@@ -282,18 +489,58 @@ namespace tvj
 		using const_iterator = inorder_const_iterator;
 		using iterator = inorder_iterator;
 
+		// the pool allocating the nodes, which can be shared by trees of the same element type
+		using pool_type = node_pool<BT_Node>;
+
 	public:
 
 		// constructor
 		binary_tree();
 
+		// constructor with a pool shared with other trees (which must outlive this tree)
+		explicit binary_tree(pool_type& pool);
+
 		// copy constructor
 		binary_tree(const binary_tree& tree);
 
+		// copy assignment, the nodes are copied into the pool of this tree (its own one or the shared one)
+		binary_tree& operator=(const binary_tree& tree);
+
 		binary_tree(const const_iterator& root_iter);
 
 		~binary_tree();
 
+		/**
+		 * brief: replace the tree by a balanced one whose inorder sequence is the sorted sequence
+		 * param: the sorted sequence
+		 * return: the tree itself
+		 */
+		binary_tree& build_balanced(const vector<Elem>& sorted);
+
+		/**
+		 * brief: replace the tree by the one with the preorder and the inorder sequences
+		 *        (the elements are supposed to be distinct, otherwise std::invalid_argument is thrown if they do not match)
+		 * param: the preorder and the inorder sequences
+		 * return: the tree itself
+		 */
+		binary_tree& build_from_preorder(const vector<Elem>& preorder, const vector<Elem>& inorder);
+
+		/**
+		 * brief: replace the tree by the one with the postorder and the inorder sequences
+		 *        (the elements are supposed to be distinct, otherwise std::invalid_argument is thrown if they do not match)
+		 * param: the postorder and the inorder sequences
+		 * return: the tree itself
+		 */
+		binary_tree& build_from_postorder(const vector<Elem>& postorder, const vector<Elem>& inorder);
+
+		/**
+		 * brief: replace the tree by the one with the level-order sequence, in which the children of each node follow
+		 *        those of the node before it, and a missing child is the null marker (those at the end can be left out or be more than needed)
+		 * param: the level-order sequence and the null marker
+		 * return: the tree itself
+		 */
+		binary_tree& build_from_level_order(const vector<Elem>& level_order, const Elem& null_marker);
+
 	protected:
 		BT_Node* _get_iter_node(const const_iterator& iter) const;
 
@@ -384,7 +631,23 @@ namespace tvj
 
 	template<typename Elem>
 	inline binary_tree<Elem>::BT_Node::BT_Node(BT_Node* parent, Elem data, BT_Node* LChild, BT_Node* RChild)
-		: parent_(parent), L_child_(LChild), R_child_(RChild), data_(data) { }
+		: parent_(parent), L_child_(LChild), R_child_(RChild), data_(data)
+	{
+		if (LChild)
+		{
+			LChild->parent_ = this;
+#ifdef TVJ_BT_SUBTREE_SIZE
+			subtree_size_ += LChild->subtree_size_;
+#endif
+		}
+		if (RChild)
+		{
+			RChild->parent_ = this;
+#ifdef TVJ_BT_SUBTREE_SIZE
+			subtree_size_ += RChild->subtree_size_;
+#endif
+		}
+	}
 
 	template<typename Elem>
 	inline binary_tree<Elem>::binary_tree()
@@ -392,14 +655,32 @@ namespace tvj
 		// root_parent_.R_child_ = &R_end_;
 	}
 
+	template<typename Elem>
+	inline binary_tree<Elem>::binary_tree(pool_type& pool)
+		: pool_(&pool) { }
+
 	template<typename Elem>
 	inline binary_tree<Elem>::binary_tree(const binary_tree& tree)
 	{
-		this->set_root(*tree.croot());
+		if (!tree.root_parent_.L_child_) return;
+		this->set_root(tree.root_parent_.L_child_->data_);
 		_set_subtree(tree.root_parent_.L_child_, this->root_parent_.L_child_);
-		_preorder_update();
-		_inorder_update();
-		_postorder_update();
+	}
+
+	template<typename Elem>
+	inline binary_tree<Elem>& binary_tree<Elem>::operator=(const binary_tree& tree)
+	{
+		if (this != &tree)
+		{
+			_clear();
+			if (tree.root_parent_.L_child_)
+			{
+				pool_->reserve(tree.size_);
+				this->set_root(tree.root_parent_.L_child_->data_);
+				_set_subtree(tree.root_parent_.L_child_, this->root_parent_.L_child_);
+			}
+		}
+		return *this;
 	}
 
 	template<typename Elem>
@@ -408,51 +689,244 @@ namespace tvj
 	{
 		this->set_root(*root_iter);
 		_set_subtree(_get_iter_node(root_iter), this->root_parent_.L_child_);
-		_preorder_update();
-		_inorder_update();
-		_postorder_update();
 	}
 
 	template<typename Elem>
 	inline binary_tree<Elem>::~binary_tree()
 	{
-		vector<BT_Node*>* to_delete__[3] = { &sequence_pre_, &sequence_in_, &sequence_post_ };
-		delete_vectors_with_same_content_pointers(3, to_delete__);
+		// the own pool releases its slabs all at once, so the nodes only need to be visited to be destructed
+		if (pool_ != &own_pool_ || !std::is_trivially_destructible<Elem>::value)
+		{
+			_destroy_subtree(root_parent_.L_child_);
+		}
+	}
+
+	template<typename Elem>
+	template<typename... Args>
+	inline typename binary_tree<Elem>::BT_Node* binary_tree<Elem>::_new_node(Args&&... args)
+	{
+		return pool_->create(std::forward<Args>(args)...);
+	}
+
+	template<typename Elem>
+	inline void binary_tree<Elem>::_destroy_subtree(BT_Node* node) noexcept
+	{
+		if (!node) return;
+		segmented_stack<BT_Node*> s__;
+		s__.push(node);
+		while (!s__.empty())
+		{
+			BT_Node* p__ = s__.pop();
+			if (p__->L_child_) s__.push(p__->L_child_);
+			if (p__->R_child_) s__.push(p__->R_child_);
+			pool_->destroy(p__);
+		}
+	}
+
+	template<typename Elem>
+	inline void binary_tree<Elem>::_clear() noexcept
+	{
+		_destroy_subtree(root_parent_.L_child_);
+		root_parent_.L_child_ = nullptr;
+		size_ = 0;
+		_invalidate_sequences();
+	}
+
+	template<typename Elem>
+	inline void binary_tree<Elem>::_build_from_sequences(const vector<Elem>& sequence, const vector<Elem>& inorder, bool is_postorder)
+	{
+		_clear();
+		const size_t n__ = sequence.size();
+		if (n__ != inorder.size()) throw std::invalid_argument("The sequences of different sizes in tvj::binary_tree.");
+		if (n__ == 0) return;
+		pool_->reserve(n__);
+		// the postorder sequence read backwards is the preorder one of the mirror tree,
+		// so it is built the same way from the inorder sequence read backwards with the children swapped
+		root_parent_.L_child_ = _new_node(&root_parent_, sequence[is_postorder ? n__ - 1 : 0]);
+		size_ = 1;
+		// the nodes whose second subtree is not started yet, the one next in the inorder sequence on the top
+		segmented_stack<BT_Node*> s__;
+		s__.push(root_parent_.L_child_);
+		size_t j = 0; // the number of nodes finished, in the inorder sequence
+		bool matched__ = true;
+		for (size_t i = 1; i != n__; i++)
+		{
+			const Elem& data__ = sequence[is_postorder ? n__ - 1 - i : i];
+			BT_Node* p__ = s__.top();
+			if (!(p__->data_ == inorder[is_postorder ? n__ - 1 - j : j]))
+			{
+				BT_Node*& child__ = is_postorder ? p__->R_child_ : p__->L_child_;
+				child__ = _new_node(p__, data__);
+				s__.push(child__);
+			}
+			else
+			{
+				// the first subtree of each node popped is done, the new node starts the second subtree of the last one
+				do
+				{
+					p__ = s__.pop();
+					j++;
+				} while (!s__.empty() && j != n__ && s__.top()->data_ == inorder[is_postorder ? n__ - 1 - j : j]);
+				if (j == n__)
+				{
+					matched__ = false;
+					break;
+				}
+				BT_Node*& child__ = is_postorder ? p__->L_child_ : p__->R_child_;
+				child__ = _new_node(p__, data__);
+				s__.push(child__);
+			}
+			size_++;
+		}
+		// the nodes left finish in order
+		for (; matched__ && !s__.empty(); j++)
+		{
+			matched__ = j != n__ && s__.pop()->data_ == inorder[is_postorder ? n__ - 1 - j : j];
+		}
+		if (!matched__ || j != n__)
+		{
+			_clear();
+			throw std::invalid_argument("The sequences do not match in tvj::binary_tree.");
+		}
+#ifdef TVJ_BT_SUBTREE_SIZE
+		_recount_subtree_sizes();
+#endif
+		_invalidate_sequences(); // each is built once when it is first used
+	}
+
+#ifdef TVJ_BT_SUBTREE_SIZE
+	template<typename Elem>
+	inline void binary_tree<Elem>::_recount_subtree_sizes() noexcept
+	{
+		for (BT_Node* p__ = _first(POSTORDER); p__ != &root_parent_; p__ = _next(POSTORDER, p__))
+		{
+			p__->subtree_size_ = 1 + _subtree_size(p__->L_child_) + _subtree_size(p__->R_child_);
+		}
+	}
+#endif
+
+	template<typename Elem>
+	inline binary_tree<Elem>& binary_tree<Elem>::build_balanced(const vector<Elem>& sorted)
+	{
+		_clear();
+		if (sorted.size() == 0) return *this;
+		pool_->reserve(sorted.size());
+		// a range [first, last) of the sorted sequence, whose middle becomes a child of the parent
+		struct _range
+		{
+			size_t first_, last_;
+			BT_Node* parent_;
+			bool is_right_;
+		};
+		segmented_stack<_range> s__;
+		s__.push(_range{ 0, sorted.size(), &root_parent_, false });
+		while (!s__.empty())
+		{
+			const _range range__ = s__.pop();
+			const size_t middle__ = range__.first_ + (range__.last_ - range__.first_) / 2;
+			BT_Node* node__ = _new_node(range__.parent_, sorted[middle__]);
+			(range__.is_right_ ? range__.parent_->R_child_ : range__.parent_->L_child_) = node__;
+#ifdef TVJ_BT_SUBTREE_SIZE
+			node__->subtree_size_ = range__.last_ - range__.first_;
+#endif
+			if (middle__ + 1 != range__.last_) s__.push(_range{ middle__ + 1, range__.last_, node__, true });
+			if (range__.first_ != middle__) s__.push(_range{ range__.first_, middle__, node__, false });
+		}
+		size_ = sorted.size();
+		_invalidate_sequences(); // each is built once when it is first used
+		return *this;
+	}
+
+	template<typename Elem>
+	inline binary_tree<Elem>& binary_tree<Elem>::build_from_preorder(const vector<Elem>& preorder, const vector<Elem>& inorder)
+	{
+		_build_from_sequences(preorder, inorder, false);
+		return *this;
+	}
+
+	template<typename Elem>
+	inline binary_tree<Elem>& binary_tree<Elem>::build_from_postorder(const vector<Elem>& postorder, const vector<Elem>& inorder)
+	{
+		_build_from_sequences(postorder, inorder, true);
+		return *this;
+	}
+
+	template<typename Elem>
+	inline binary_tree<Elem>& binary_tree<Elem>::build_from_level_order(const vector<Elem>& level_order, const Elem& null_marker)
+	{
+		_clear();
+		const size_t n__ = level_order.size();
+		size_t count__ = 0;
+		for (size_t i = 0; i != n__; i++) count__ += !(level_order[i] == null_marker);
+		if (count__ == 0) return *this; // only null markers (if any)
+		if (level_order[0] == null_marker) throw std::invalid_argument("Elements after a null root in the level-order sequence of tvj::binary_tree.");
+		pool_->reserve(count__);
+		// the nodes are made in level order, so those waiting for their children are a queue of the nodes made
+		vector<BT_Node*> queue__(count__, nullptr);
+		size_t head__ = 0, tail__ = 0;
+		root_parent_.L_child_ = queue__[tail__++] = _new_node(&root_parent_, level_order[0]);
+		for (size_t i = 1; i < n__; )
+		{
+			if (head__ == tail__)
+			{
+				// all the nodes are done, so only null markers may be left
+				if (tail__ == count__) break;
+				_clear();
+				throw std::invalid_argument("Too many elements in the level-order sequence of tvj::binary_tree.");
+			}
+			BT_Node* p__ = queue__[head__++];
+			if (!(level_order[i] == null_marker)) p__->L_child_ = queue__[tail__++] = _new_node(p__, level_order[i]);
+			if (++i == n__) break;
+			if (!(level_order[i] == null_marker)) p__->R_child_ = queue__[tail__++] = _new_node(p__, level_order[i]);
+			i++;
+		}
+		size_ = count__;
+#ifdef TVJ_BT_SUBTREE_SIZE
+		_recount_subtree_sizes();
+#endif
+		_invalidate_sequences(); // each is built once when it is first used
+		return *this;
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::BT_Node* binary_tree<Elem>::_get_iter_node(const const_iterator& iter) const
 	{
-		return iter.sequence_[iter.index_];
+		return iter.node_;
 	}
 
 	template<typename Elem>
 	inline void binary_tree<Elem>::_set_subtree(const BT_Node* original_node, BT_Node* this_node)
 	{
 		if (!original_node || !this_node) return; // no use, but just for sure
+#ifdef TVJ_BT_SUBTREE_SIZE
+		this_node->subtree_size_ = original_node->subtree_size_; // the same shape is copied below
+#endif
 		if (original_node->L_child_)
 		{
-			this_node->L_child_ = new BT_Node(this_node, original_node->L_child_->data_, nullptr, nullptr);
+			this_node->L_child_ = _new_node(this_node, original_node->L_child_->data_, nullptr, nullptr);
 			this->size_++;
 			_set_subtree(original_node->L_child_, this_node->L_child_);
 		}
 		if (original_node->R_child_)
 		{
-			this_node->R_child_ = new BT_Node(this_node, original_node->R_child_->data_, nullptr, nullptr);
+			this_node->R_child_ = _new_node(this_node, original_node->R_child_->data_, nullptr, nullptr);
 			this->size_++;
 			_set_subtree(original_node->R_child_, this_node->R_child_);
 		}
 	}
 
 	template<typename Elem>
-	inline void binary_tree<Elem>::_preorder_update() noexcept
+	inline void binary_tree<Elem>::_preorder_update() const noexcept
 	{
 		sequence_pre_.clear();
 		BT_Node* p__ = root_parent_.L_child_;
-		stack<BT_Node*> s__;
+		segmented_stack<BT_Node*> s__;
 		s__.push(nullptr);
 		while (p__)
 		{
+#ifndef TVJ_BT_SUBTREE_SIZE
+			p__->position_[PREORDER] = sequence_pre_.size();
+#endif
 			sequence_pre_.push_back(p__);
 			if (p__->R_child_)
 			{
@@ -467,14 +941,15 @@ namespace tvj
 				p__ = s__.pop();
 			}
 		}
+		preorder_updated = true;
 	}
 
 	template<typename Elem>
-	inline void binary_tree<Elem>::_inorder_update() noexcept
+	inline void binary_tree<Elem>::_inorder_update() const noexcept
 	{
 		sequence_in_.clear();
 		BT_Node* p__ = root_parent_.L_child_;
-		stack<BT_Node*> s__;
+		segmented_stack<BT_Node*> s__;
 		do
 		{
 			while (p__)
@@ -484,14 +959,19 @@ namespace tvj
 			}
 			if (!s__.empty())
 			{
-				sequence_in_.push_back(p__ = s__.pop());
+				p__ = s__.pop();
+#ifndef TVJ_BT_SUBTREE_SIZE
+				p__->position_[INORDER] = sequence_in_.size();
+#endif
+				sequence_in_.push_back(p__);
 				p__ = p__->R_child_;
 			}
 		} while (p__ || !s__.empty());
+		inorder_updated = true;
 	}
 
 	template<typename Elem>
-	inline void binary_tree<Elem>::_postorder_update() noexcept
+	inline void binary_tree<Elem>::_postorder_update() const noexcept
 	{
 		sequence_post_.clear();
 		struct _LR_BT_Node__
@@ -503,7 +983,7 @@ namespace tvj
 			_LR_BT_Node__() : _node__(nullptr), tag_(_L__) { }
 			_LR_BT_Node__(BT_Node* node, _LR_tag__ tag)	: _node__(node), tag_(tag) { }
 		};
-		stack<_LR_BT_Node__> s__;
+		segmented_stack<_LR_BT_Node__> s__;
 		BT_Node* p__ = root_parent_.L_child_;
 		do
 		{
@@ -517,23 +997,231 @@ namespace tvj
 			bool unfinished__ = true;
 			while (unfinished__ && !s__.empty())
 			{
-				_LR_BT_Node__ top_node__(s__.pop());
+				_LR_BT_Node__& top_node__ = s__.top(); // retagged in place instead of popped and pushed again
 				p__ = top_node__._node__;
 				if (top_node__.tag_ == _LR_BT_Node__::_L__)
 				{
 					top_node__.tag_ = _LR_BT_Node__::_R__;
-					s__.push(top_node__);
 					p__ = p__->R_child_;
 					unfinished__ = false;
 				}
 				else
 				{
-					sequence_post_.push_back(top_node__._node__);
+					p__ = s__.pop()._node__;
+#ifndef TVJ_BT_SUBTREE_SIZE
+					p__->position_[POSTORDER] = sequence_post_.size();
+#endif
+					sequence_post_.push_back(p__);
 				}
 			}
 		} while (!s__.empty());
+		postorder_updated = true;
+	}
+
+	template<typename Elem>
+	inline void binary_tree<Elem>::_invalidate_sequences() noexcept
+	{
+		preorder_updated = inorder_updated = postorder_updated = false;
+	}
+
+	template<typename Elem>
+	inline vector<typename binary_tree<Elem>::BT_Node*>& binary_tree<Elem>::_sequence(Traversal_Order order) const noexcept
+	{
+		switch (order)
+		{
+		case PREORDER:
+			if (!preorder_updated) _preorder_update();
+			return sequence_pre_;
+		case POSTORDER:
+			if (!postorder_updated) _postorder_update();
+			return sequence_post_;
+		default:
+			if (!inorder_updated) _inorder_update();
+			return sequence_in_;
+		}
+	}
+
+	template<typename Elem>
+	inline void binary_tree<Elem>::update_sequence(Traversal_Order order) const noexcept
+	{
+		_sequence(order);
+	}
+
+	template<typename Elem>
+	inline typename binary_tree<Elem>::BT_Node* binary_tree<Elem>::_node_at(Traversal_Order order, size_t index) const
+	{
+		if (index >= size_) throw std::out_of_range("Index out of range in tvj::binary_tree.");
+#ifdef TVJ_BT_SUBTREE_SIZE
+		// the sequence of a subtree is the node, the left and the right subtrees in preorder,
+		// the left subtree, the node and the right subtree in inorder,
+		// and the left and the right subtrees followed by the node in postorder
+		BT_Node* p__ = root_parent_.L_child_;
+		for (;;)
+		{
+			const size_t left__ = _subtree_size(p__->L_child_);
+			if (order == PREORDER)
+			{
+				if (index == 0) return p__;
+				index--;
+			}
+			else if (order == INORDER)
+			{
+				if (index == left__) return p__;
+			}
+			else if (index == p__->subtree_size_ - 1) return p__;
+			if (index < left__)
+			{
+				p__ = p__->L_child_;
+			}
+			else
+			{
+				index -= left__ + (order == INORDER);
+				p__ = p__->R_child_;
+			}
+		}
+#else
+		return _sequence(order)[index];
+#endif
+	}
+
+	template<typename Elem>
+	inline size_t binary_tree<Elem>::_index_of(Traversal_Order order, const BT_Node* node) const noexcept
+	{
+		if (!node || node == &root_parent_) return size_;
+#ifdef TVJ_BT_SUBTREE_SIZE
+		// the index inside its own subtree, then add what comes before each subtree on the way up
+		size_t index__ = order == PREORDER ? 0 : order == INORDER ? _subtree_size(node->L_child_) : node->subtree_size_ - 1;
+		for (; node->parent_ != &root_parent_; node = node->parent_)
+		{
+			const BT_Node* parent__ = node->parent_;
+			if (parent__->R_child_ == node)
+			{
+				index__ += _subtree_size(parent__->L_child_) + (order != POSTORDER);
+			}
+			else if (order == PREORDER)
+			{
+				index__++;
+			}
+		}
+		return index__;
+#else
+		const vector<BT_Node*>& sequence__ = _sequence(order);
+		const size_t index__ = node->position_[order];
+		// only trusted if the sequence agrees, as the room of a removed node can be reused
+		return index__ < sequence__.size() && sequence__[index__] == node ? index__ : size_;
+#endif
+	}
+
+	template<typename Elem>
+	inline typename binary_tree<Elem>::BT_Node* binary_tree<Elem>::_first(Traversal_Order order) const noexcept
+	{
+		BT_Node* p__ = root_parent_.L_child_;
+		if (!p__) return const_cast<BT_Node*>(&root_parent_);
+		if (order == INORDER)
+		{
+			while (p__->L_child_) p__ = p__->L_child_;
+		}
+		else if (order == POSTORDER)
+		{
+			while (p__->L_child_ || p__->R_child_) p__ = p__->L_child_ ? p__->L_child_ : p__->R_child_;
+		}
+		return p__;
+	}
+
+	template<typename Elem>
+	inline typename binary_tree<Elem>::BT_Node* binary_tree<Elem>::_next(Traversal_Order order, BT_Node* node) const noexcept
+	{
+		BT_Node* const end__ = const_cast<BT_Node*>(&root_parent_);
+		if (node == end__) return end__;
+		switch (order)
+		{
+		case PREORDER:
+			if (node->L_child_) return node->L_child_;
+			if (node->R_child_) return node->R_child_;
+			// up to the first ancestor entered from the left with a right subtree
+			for (; node != end__; node = node->parent_)
+			{
+				if (node->parent_->L_child_ == node && node->parent_->R_child_) return node->parent_->R_child_;
+			}
+			return end__;
+		case POSTORDER:
+			if (node->parent_->L_child_ == node && node->parent_->R_child_)
+			{
+				// the first node of the right sibling subtree
+				node = node->parent_->R_child_;
+				while (node->L_child_ || node->R_child_) node = node->L_child_ ? node->L_child_ : node->R_child_;
+				return node;
+			}
+			return node->parent_; // the parent of the root is the end
+		default:
+			if (node->R_child_)
+			{
+				node = node->R_child_;
+				while (node->L_child_) node = node->L_child_;
+				return node;
+			}
+			// the root is the left child of the end, so the last node goes up to it
+			while (node->parent_->R_child_ == node) node = node->parent_;
+			return node->parent_;
+		}
+	}
+
+	template<typename Elem>
+	inline typename binary_tree<Elem>::BT_Node* binary_tree<Elem>::_previous(Traversal_Order order, BT_Node* node) const noexcept
+	{
+		BT_Node* const end__ = const_cast<BT_Node*>(&root_parent_);
+		if (!node) return nullptr;
+		switch (order)
+		{
+		case PREORDER:
+			if (node == end__ || (node->parent_->R_child_ == node && node->parent_->L_child_))
+			{
+				// the last node of the left sibling subtree (of the whole tree from the end)
+				node = node == end__ ? node->L_child_ : node->parent_->L_child_;
+				while (node && (node->L_child_ || node->R_child_)) node = node->R_child_ ? node->R_child_ : node->L_child_;
+				return node;
+			}
+			return node->parent_ == end__ ? nullptr : node->parent_;
+		case POSTORDER:
+			if (node->R_child_) return node->R_child_;
+			if (node->L_child_) return node->L_child_;
+			if (node == end__) return nullptr;
+			// up to the first ancestor entered from the right with a left subtree
+			for (; node->parent_ != end__; node = node->parent_)
+			{
+				if (node->parent_->R_child_ == node && node->parent_->L_child_) return node->parent_->L_child_;
+			}
+			return nullptr;
+		default:
+			if (node->L_child_)
+			{
+				node = node->L_child_;
+				while (node->R_child_) node = node->R_child_;
+				return node;
+			}
+			while (node != end__ && node->parent_->L_child_ == node) node = node->parent_;
+			return node == end__ ? nullptr : node->parent_;
+		}
 	}
 
+#ifdef TVJ_BT_SUBTREE_SIZE
+	template<typename Elem>
+	inline size_t binary_tree<Elem>::_subtree_size(const BT_Node* node) noexcept
+	{
+		return node ? node->subtree_size_ : 0;
+	}
+
+	template<typename Elem>
+	inline void binary_tree<Elem>::_update_subtree_sizes(BT_Node* node, bool grow) noexcept
+	{
+		for (; node != &root_parent_; node = node->parent_)
+		{
+			if (grow) node->subtree_size_++;
+			else node->subtree_size_--;
+		}
+	}
+#endif
+
 	template<typename Elem>
 	inline size_t binary_tree<Elem>::size() const noexcept
 	{
@@ -549,19 +1237,19 @@ namespace tvj
 	template<typename Elem>
 	inline const Elem& binary_tree<Elem>::inorder_at(size_t index) const
 	{
-		return this->sequence_in_[index];
+		return this->_node_at(INORDER, index)->data_;
 	}
 
 	template<typename Elem>
 	inline const Elem& binary_tree<Elem>::preorder_at(size_t index) const
 	{
-		return this->sequence_pre_[index];
+		return this->_node_at(PREORDER, index)->data_;
 	}
 
 	template<typename Elem>
 	inline const Elem& binary_tree<Elem>::postorder_at(size_t index) const
 	{
-		return this->sequence_post_[index];
+		return this->_node_at(POSTORDER, index)->data_;
 	}
 
 	template<typename Elem>
@@ -579,19 +1267,19 @@ namespace tvj
 	template<typename Elem>
 	inline Elem& binary_tree<Elem>::inorder_at(size_t index)
 	{
-		return this->sequence_in_[index];
+		return this->_node_at(INORDER, index)->data_;
 	}
 
 	template<typename Elem>
 	inline Elem& binary_tree<Elem>::preorder_at(size_t index)
 	{
-		return this->sequence_pre_[index];
+		return this->_node_at(PREORDER, index)->data_;
 	}
 
 	template<typename Elem>
 	inline Elem& binary_tree<Elem>::postorder_at(size_t index)
 	{
-		return this->sequence_post_[index];
+		return this->_node_at(POSTORDER, index)->data_;
 	}
 
 	template<typename Elem>
@@ -603,50 +1291,29 @@ namespace tvj
 	template<typename Elem>
 	inline void binary_tree<Elem>::_remove_node(BT_Node* node)
 	{
-		iterator iter__(this, node);
-		if (iter__.degree() == 0)
+		if (node->L_child_ && node->R_child_)
 		{
-			if (iter__.is_left_child())
-			{
-				node->parent_->L_child_ = nullptr;
-			}
-			else
-			{
-				node->parent_->R_child_ = nullptr;
-			}			
+			// take the data of the inorder predecessor, which has no right child, and remove that node instead
+			BT_Node* previous__ = node->L_child_;
+			while (previous__->R_child_) previous__ = previous__->R_child_;
+			node->data_ = previous__->data_;
+			node = previous__;
 		}
-		else if (iter__.degree() == 1)
+		BT_Node* child__ = node->L_child_ ? node->L_child_ : node->R_child_;
+		if (child__) child__->parent_ = node->parent_;
+		if (node->parent_->L_child_ == node)
 		{
-			if (iter__.has_left_child())
-			{
-				if (iter__.is_left_child())
-				{
-					node->parent_->L_child_ = node->L_child_;
-				}
-				else
-				{
-					node->parent_->R_child_ = node->L_child_;
-				}
-			}
-			else
-			{
-				if (iter__.is_left_child())
-				{
-					node->parent_->L_child_ = node->R_child_;
-				}
-				else
-				{
-					node->parent_->R_child_ = node->R_child_;
-				}
-			}
+			node->parent_->L_child_ = child__;
 		}
 		else
 		{
-			auto previous_iter__ = iter__ - 1;
-			*iter__ = *previous_iter__;
-			node->R_child_ = this->_get_iter_node(previous_iter__)->L_child_;
-			this->_get_iter_node(previous_iter__)->parent_->R_child_ = nullptr;
+			node->parent_->R_child_ = child__;
 		}
+#ifdef TVJ_BT_SUBTREE_SIZE
+		_update_subtree_sizes(node->parent_, false);
+#endif
+		pool_->destroy(node);
+		_invalidate_sequences();
 	}
 
 	template<typename Elem>
@@ -658,8 +1325,7 @@ namespace tvj
 	template<typename Elem>
 	inline void binary_tree<Elem>::remove_inorder_at(size_t index)
 	{
-		_remove_node(sequence_in_[index]);
-		sequence_in_.remove_at(index);
+		_remove_node(_node_at(INORDER, index));
 		this->size_--;
 	}
 
@@ -727,12 +1393,10 @@ namespace tvj
 		}
 		else
 		{
-			BT_Node* new_node__ = new BT_Node(&root_parent_, data, nullptr, nullptr);
+			BT_Node* new_node__ = _new_node(&root_parent_, data, nullptr, nullptr);
 			root_parent_.L_child_ = new_node__;
 			size_++;
-			sequence_in_.push_back(new_node__);
-			sequence_pre_.push_back(new_node__);
-			sequence_post_.push_back(new_node__);
+			_invalidate_sequences();
 		}
 		return inorder_root();
 	}
@@ -802,12 +1466,10 @@ namespace tvj
 		}
 		else
 		{
-			BT_Node* new_node__ = new BT_Node(&root_parent_, data, nullptr, nullptr);
+			BT_Node* new_node__ = _new_node(&root_parent_, data, nullptr, nullptr);
 			root_parent_.L_child_ = new_node__;
 			size_++;
-			sequence_in_.push_back(new_node__);
-			sequence_pre_.push_back(new_node__);
-			sequence_post_.push_back(new_node__);
+			_invalidate_sequences();
 		}
 		return preorder_root();
 	}
@@ -877,12 +1539,10 @@ namespace tvj
 		}
 		else
 		{
-			BT_Node* new_node__ = new BT_Node(&root_parent_, data, nullptr, nullptr);
+			BT_Node* new_node__ = _new_node(&root_parent_, data, nullptr, nullptr);
 			root_parent_.L_child_ = new_node__;
 			size_++;
-			sequence_in_.push_back(new_node__);
-			sequence_pre_.push_back(new_node__);
-			sequence_post_.push_back(new_node__);
+			_invalidate_sequences();
 		}
 		return postorder_root();
 	}
@@ -934,7 +1594,7 @@ namespace tvj
 	template<typename Elem>
 	inline typename binary_tree<Elem>::iterator binary_tree<Elem>::begin() noexcept
 	{
-		return iterator(this, 0U);
+		return iterator(this);
 	}
 
 	template<typename Elem>
@@ -952,49 +1612,47 @@ namespace tvj
 		}
 		else
 		{
-			BT_Node* new_node__ = new BT_Node(&root_parent_, data, nullptr, nullptr);
+			BT_Node* new_node__ = _new_node(&root_parent_, data, nullptr, nullptr);
 			root_parent_.L_child_ = new_node__;
 			size_++;
-			sequence_in_.push_back(new_node__);
-			sequence_pre_.push_back(new_node__);
-			sequence_post_.push_back(new_node__);
+			_invalidate_sequences();
 		}
 		return root();
 	}
 
 	template<typename Elem>
-	inline vector<typename binary_tree<Elem>::BT_Node*>& binary_tree<Elem>::inorder_const_iterator::_sequence_ptr_to_ref() const noexcept
+	inline binary_tree<Elem>::inorder_const_iterator::inorder_const_iterator(const BT_ptr& tree)
+		: inorder_const_iterator(tree, INORDER, static_cast<size_t>(0))
 	{
-		return *this->sequence_ptr_;
+
 	}
 
 	template<typename Elem>
-	inline binary_tree<Elem>::inorder_const_iterator::inorder_const_iterator(const BT_ptr& tree)
-		: parent_tree_(tree), sequence_ptr_(&tree->sequence_in_)
+	inline binary_tree<Elem>::inorder_const_iterator::inorder_const_iterator(const BT_ptr& tree, size_t index)
+		: inorder_const_iterator(tree, INORDER, index)
 	{
 
 	}
 
 	template<typename Elem>
-	inline binary_tree<Elem>::inorder_const_iterator::inorder_const_iterator(const BT_ptr& tree, size_t index)
-		: parent_tree_(tree), index_(index), sequence_ptr_(&tree->sequence_in_)
+	inline binary_tree<Elem>::inorder_const_iterator::inorder_const_iterator(const BT_ptr& tree, BT_Node* node)
+		: inorder_const_iterator(tree, INORDER, node)
 	{
 
 	}
 
 	template<typename Elem>
-	inline binary_tree<Elem>::inorder_const_iterator::inorder_const_iterator(const BT_ptr& tree, BT_Node* node)
-		: parent_tree_(tree), sequence_ptr_(&tree->sequence_in_)
+	inline binary_tree<Elem>::inorder_const_iterator::inorder_const_iterator(const BT_ptr& tree, Traversal_Order order, size_t index)
+		: order_(order), parent_tree_(tree)
 	{
-		size_t index__ = _find_node_index(node);
-		if (index__ >= this->sequence_.size())
-		{
-			exit(10000 + this->sequence_.size()); // impossible
-		}
-		else
-		{
-			this->index_ = index__;
-		}
+		this->_move_to(index);
+	}
+
+	template<typename Elem>
+	inline binary_tree<Elem>::inorder_const_iterator::inorder_const_iterator(const BT_ptr& tree, Traversal_Order order, BT_Node* node)
+		: order_(order), node_(node), parent_tree_(tree)
+	{
+		// the index is found when first needed
 	}
 
 	template<typename Elem>
@@ -1009,136 +1667,72 @@ namespace tvj
 	inline binary_tree<Elem>::inorder_iterator::inorder_iterator(BT_ptr tree, BT_Node* node)
 		: inorder_const_iterator(tree, node) { }
 
+	template<typename Elem>
+	inline binary_tree<Elem>::inorder_iterator::inorder_iterator(BT_ptr tree, Traversal_Order order, size_t index)
+		: inorder_const_iterator(tree, order, index) { }
+
+	template<typename Elem>
+	inline binary_tree<Elem>::inorder_iterator::inorder_iterator(BT_ptr tree, Traversal_Order order, BT_Node* node)
+		: inorder_const_iterator(tree, order, node) { }
+
 	template<typename elem>
 	inline binary_tree<elem>::preorder_const_iterator::preorder_const_iterator(const BT_ptr& tree)
-		: inorder_const_iterator(tree)
-	{
-		this->sequence_ptr_ = &tree->sequence_pre_;
-	}
+		: inorder_const_iterator(tree, binary_tree<elem>::PREORDER, static_cast<size_t>(0)) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::preorder_const_iterator::preorder_const_iterator(const BT_ptr& tree, size_t index)
-		: inorder_const_iterator(tree, index)
-	{
-		this->sequence_ptr_ = &tree->sequence_pre_;
-	}
+		: inorder_const_iterator(tree, binary_tree<elem>::PREORDER, index) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::preorder_const_iterator::preorder_const_iterator(const BT_ptr& tree, BT_Node* node)
-		: inorder_const_iterator(tree, node)
-	{
-		this->sequence_ptr_ = &tree->sequence_pre_;
-		size_t index__ = _find_node_index(node);
-		if (index__ >= this->sequence_.size())
-		{
-			exit(10000 + this->sequence_.size());
-		}
-		else
-		{
-			this->index_ = index__;
-		}
-	}
+		: inorder_const_iterator(tree, binary_tree<elem>::PREORDER, node) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::preorder_iterator::preorder_iterator(binary_tree* tree)
-		: preorder_iterator(tree)
-	{
-		this->sequence_ptr_ = &tree->sequence_pre_;
-	}
+		: inorder_iterator(tree, binary_tree<elem>::PREORDER, static_cast<size_t>(0)) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::preorder_iterator::preorder_iterator(binary_tree* tree, size_t index)
-		: inorder_iterator(tree, index)
-	{
-		this->sequence_ptr_ = &tree->sequence_pre_;
-	}
+		: inorder_iterator(tree, binary_tree<elem>::PREORDER, index) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::preorder_iterator::preorder_iterator(binary_tree* tree, BT_Node* node)
-		: inorder_iterator(tree, node)
-	{
-		this->sequence_ptr_ = &tree->sequence_pre_;
-		size_t index__ = _find_node_index(node);
-		if (index__ >= this->sequence_.size())
-		{
-			exit(10000 + this->sequence_.size());
-		}
-		else
-		{
-			this->index_ = index__;
-		}
-	}
+		: inorder_iterator(tree, binary_tree<elem>::PREORDER, node) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::postorder_const_iterator::postorder_const_iterator(const BT_ptr& tree)
-		: inorder_const_iterator(tree)
-	{
-		this->sequence_ptr_ = &tree->sequence_post_;
-	}
+		: inorder_const_iterator(tree, binary_tree<elem>::POSTORDER, static_cast<size_t>(0)) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::postorder_const_iterator::postorder_const_iterator(const BT_ptr& tree, size_t index)
-		: inorder_const_iterator(tree, index)
-	{
-		this->sequence_ptr_ = &tree->sequence_post_;
-	}
+		: inorder_const_iterator(tree, binary_tree<elem>::POSTORDER, index) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::postorder_const_iterator::postorder_const_iterator(const BT_ptr& tree, BT_Node* node)
-		: inorder_const_iterator(tree, node)
-	{
-		this->sequence_ptr_ = &tree->sequence_post_;
-		size_t index__ = _find_node_index(node);
-		if (index__ >= this->sequence_.size())
-		{
-			exit(10000 + this->sequence_.size());
-		}
-		else
-		{
-			this->index_ = index__;
-		}
-	}
+		: inorder_const_iterator(tree, binary_tree<elem>::POSTORDER, node) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::postorder_iterator::postorder_iterator(binary_tree* tree)
-		: inorder_iterator(tree)
-	{
-		this->sequence_ptr_ = &tree->sequence_post_;
-	}
+		: inorder_iterator(tree, binary_tree<elem>::POSTORDER, static_cast<size_t>(0)) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::postorder_iterator::postorder_iterator(binary_tree* tree, size_t index)
-		: inorder_iterator(tree, index)
-	{
-		this->sequence_ptr_ = &tree->sequence_post_;
-	}
+		: inorder_iterator(tree, binary_tree<elem>::POSTORDER, index) { }
 
 	template<typename elem>
 	inline binary_tree<elem>::postorder_iterator::postorder_iterator(binary_tree* tree, BT_Node* node)
-		: inorder_iterator(tree, node)
-	{
-		this->sequence_ptr_ = &tree->sequence_post_;
-		size_t index__ = _find_node_index(node);
-		if (index__ >= this->sequence_.size())
-		{
-			exit(10000 + this->sequence_.size());
-		}
-		else
-		{
-			this->index_ = index__;
-		}
-	}
+		: inorder_iterator(tree, binary_tree<elem>::POSTORDER, node) { }
 
 	template<typename Elem>
 	inline bool binary_tree<Elem>::inorder_const_iterator::is_root() const noexcept
 	{
-		return this->sequence_[this->index_] == this->parent_tree_->root_parent_.L_child_;
+		return this->node_ == this->parent_tree_->root_parent_.L_child_;
 	}
 
 	template<typename Elem>
 	inline bool binary_tree<Elem>::inorder_const_iterator::is_leaf() const noexcept
 	{
-		return !this->sequence_[this->index_]->L_child_ && !this->sequence_[this->index_]->R_child_;
+		return !this->node_->L_child_ && !this->node_->R_child_;
 	}
 
 	template<typename Elem>
@@ -1150,31 +1744,31 @@ namespace tvj
 	template<typename Elem>
 	inline bool binary_tree<Elem>::inorder_const_iterator::is_left_child() const noexcept
 	{
-		return this->sequence_[this->index_]->parent_->L_child_ == this->sequence_[this->index_];
+		return this->node_->parent_->L_child_ == this->node_;
 	}
 
 	template<typename Elem>
 	inline bool binary_tree<Elem>::inorder_const_iterator::is_right_child() const noexcept
 	{
-		return this->sequence_[this->index_]->parent_->R_child_ == this->sequence_[this->index_];
+		return this->node_->parent_->R_child_ == this->node_;
 	}
 
 	template<typename Elem>
 	inline bool binary_tree<Elem>::inorder_const_iterator::is_before_begin() const noexcept
 	{
-		return this->index_ == negative_1;
+		return !this->node_;
 	}
 
 	template<typename Elem>
 	inline bool binary_tree<Elem>::inorder_const_iterator::has_left_child() const noexcept
 	{
-		return this->sequence_[this->index_]->L_child_ != nullptr;
+		return this->node_->L_child_ != nullptr;
 	}
 
 	template<typename Elem>
 	inline bool binary_tree<Elem>::inorder_const_iterator::has_right_child() const noexcept
 	{
-		return this->sequence_[this->index_]->R_child_ != nullptr;
+		return this->node_->R_child_ != nullptr;
 	}
 
 	template<typename Elem>
@@ -1186,76 +1780,86 @@ namespace tvj
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_const_iterator binary_tree<Elem>::inorder_const_iterator::parent() const
 	{
-		return inorder_const_iterator(this->parent_tree_, (*this->sequence_ptr_)[this->index_]->parent);
+		return inorder_const_iterator(this->parent_tree_, this->order_, this->node_->parent_);
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_const_iterator binary_tree<Elem>::inorder_const_iterator::left_child() const
 	{
-		return inorder_const_iterator(this->parent_tree_, (*this->sequence_ptr_)[this->index_]->L_child_);
+		return inorder_const_iterator(this->parent_tree_, this->order_, this->node_->L_child_);
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_const_iterator binary_tree<Elem>::inorder_const_iterator::right_child() const
 	{
-		return inorder_const_iterator(this->parent_tree_, (*this->sequence_ptr_)[this->index_]->R_child_);
+		return inorder_const_iterator(this->parent_tree_, this->order_, this->node_->R_child_);
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_const_iterator binary_tree<Elem>::inorder_const_iterator::sibling() const
 	{
-		return inorder_const_iterator(this->parent_tree_,
+		return inorder_const_iterator(this->parent_tree_, this->order_,
 			(this->is_left_child()) ?
-			this->sequence_[this->index_]->parent_->R_child_ : this->sequence_[this->index_]->parent_->L_child_);
+			this->node_->parent_->R_child_ : this->node_->parent_->L_child_);
 	}
 
 	template<typename Elem>
 	inline size_t binary_tree<Elem>::inorder_const_iterator::_find_node_index(BT_Node* node) const noexcept
 	{
-		size_t i = 0;
-		while (i != this->sequence_.size())
+		return this->parent_tree_->_index_of(this->order_, node);
+	}
+
+	template<typename Elem>
+	inline size_t binary_tree<Elem>::inorder_const_iterator::_index() const noexcept
+	{
+		if (this->node_) this->index_ = _find_node_index(this->node_);
+		return this->index_;
+	}
+
+	template<typename Elem>
+	inline void binary_tree<Elem>::inorder_const_iterator::_move_to(size_t index) noexcept
+	{
+		const BT_ptr tree__ = this->parent_tree_;
+		this->index_ = index;
+		if (index == 0) this->node_ = tree__->_first(this->order_);
+		else if (index < tree__->size_) this->node_ = tree__->_node_at(this->order_, index);
+		else this->node_ = index == negative_1 ? nullptr : &tree__->root_parent_;
+	}
+
+	template<typename Elem>
+	inline void binary_tree<Elem>::inorder_const_iterator::_step(bool forward) noexcept
+	{
+		if (forward)
 		{
-			if (this->sequence_[i] == node)
+			if (!this->node_) this->_move_to(0);
+			else if (this->node_ != &this->parent_tree_->root_parent_)
 			{
-				return i;
-			}
-			else
-			{
-				i++;
+				this->node_ = this->parent_tree_->_next(this->order_, this->node_);
+				this->index_++; // checked before it is used
 			}
 		}
-		return i;
+		else if (this->node_)
+		{
+			this->node_ = this->parent_tree_->_previous(this->order_, this->node_);
+			this->index_--;
+		}
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_iterator binary_tree<Elem>::inorder_iterator::set_left_child(const Elem& data)
 	{
-		if (this->sequence_[this->index_]->L_child_)
+		if (this->node_->L_child_)
 		{
-			this->sequence_[this->index_]->L_child_->data_ = data;
+			this->node_->L_child_->data_ = data;
 		}
 		else
 		{
-			BT_Node* new_node__ = new BT_Node(this->sequence_[this->index_], data, nullptr, nullptr);
-			this->sequence_[this->index_]->L_child_ = new_node__;
+			this->node_->L_child_ = this->parent_tree_->_new_node(this->node_, data, nullptr, nullptr);
 			this->parent_tree_->size_++;
-
-			// update the inorder sequence
-			this->sequence_.push_back(new_node__);        // to ensure no overflow
-			for (size_t i = this->sequence_.size(); i != this->index_; i--)
-			{
-				this->sequence_[i] = this->sequence_[i - 1];
-			}
-			this->sequence_[this->index_++] = new_node__; // increment index_ as the new node is before this
-			this->parent_tree_->_preorder_update();
-			this->parent_tree_->_postorder_update();
-			/* USED FOR TEST */
-			//std::cout << "L ";
-			//for (size_t i = 0; i != this->sequence_.size(); i++)
-			//{
-			//	std::cout << this->sequence_[i]->data_ << ' ';
-			//}
-			//std::cout << std::endl;
+#ifdef TVJ_BT_SUBTREE_SIZE
+			this->parent_tree_->_update_subtree_sizes(this->node_, true);
+#endif
+			this->parent_tree_->_invalidate_sequences(); // rebuilt when next used, so building a tree is O(n)
 		}
 		return *this;
 	}
@@ -1263,33 +1867,18 @@ namespace tvj
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_iterator binary_tree<Elem>::inorder_iterator::set_right_child(const Elem& data)
 	{
-		if (this->sequence_[this->index_]->R_child_)
+		if (this->node_->R_child_)
 		{
-			this->sequence_[this->index_]->R_child_->data_ = data;
+			this->node_->R_child_->data_ = data;
 		}
 		else
 		{
-			BT_Node* new_node__ = new BT_Node(this->sequence_[this->index_], data, nullptr, nullptr);
-			this->sequence_[this->index_]->R_child_ = new_node__;
+			this->node_->R_child_ = this->parent_tree_->_new_node(this->node_, data, nullptr, nullptr);
 			this->parent_tree_->size_++;
-
-			// update the inorder sequence
-			this->sequence_.push_back(new_node__); // to ensure no overflow
-			for (size_t i = this->sequence_.size(); i != this->index_ + 1; i--)
-			{
-				this->sequence_[i] = this->sequence_[i - 1];
-			}
-			this->sequence_[this->index_ + 1] = new_node__;
-			this->parent_tree_->_preorder_update();
-			this->parent_tree_->_postorder_update();
-
-			/* USED FOR TEST */
-			//std::cout << "R ";
-			//for (size_t i = 0; i != this->sequence_.size(); i++)
-			//{
-			//	std::cout << this->sequence_[i]->data_ << ' ';
-			//}
-			//std::cout << std::endl;
+#ifdef TVJ_BT_SUBTREE_SIZE
+			this->parent_tree_->_update_subtree_sizes(this->node_, true);
+#endif
+			this->parent_tree_->_invalidate_sequences();
 		}
 		return *this;
 	}
@@ -1297,52 +1886,52 @@ namespace tvj
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_iterator binary_tree<Elem>::inorder_iterator::parent()
 	{
-		return inorder_iterator(this->parent_tree_, this->sequence_[this->index_]->parent_);
+		return inorder_iterator(this->parent_tree_, this->order_, this->node_->parent_);
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_iterator binary_tree<Elem>::inorder_iterator::left_child()
 	{
-		return inorder_iterator(this->parent_tree_, this->sequence_[this->index_]->L_child_);
+		return inorder_iterator(this->parent_tree_, this->order_, this->node_->L_child_);
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_iterator binary_tree<Elem>::inorder_iterator::right_child()
 	{
-		return inorder_iterator(this->parent_tree_, this->sequence_[this->index_]->R_child_);
+		return inorder_iterator(this->parent_tree_, this->order_, this->node_->R_child_);
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_iterator binary_tree<Elem>::inorder_iterator::sibling()
 	{
-		return inorder_iterator(this->parent_tree_,
+		return inorder_iterator(this->parent_tree_, this->order_,
 			(this->is_left_child()) ?
-			this->sequence_[this->index_]->parent_->R_child_ : this->sequence_[this->index_]->parent_->L_child_);
+			this->node_->parent_->R_child_ : this->node_->parent_->L_child_);
 	}
 
 	template<typename Elem>
 	inline const Elem& binary_tree<Elem>::inorder_const_iterator::operator*() const
 	{
-		return this->sequence_[this->index_]->data_;
+		return this->node_->data_;
 	}
 
 	template<typename Elem>
 	inline const Elem* binary_tree<Elem>::inorder_const_iterator::operator->() const
 	{
-		return &this->sequence_[this->index_]->data_;
+		return &this->node_->data_;
 	}
 
 	template<typename Elem>
 	inline auto binary_tree<Elem>::inorder_const_iterator::operator++()
 	{
-		this->index_++;
+		this->_step(true);
 		return *this;
 	}
 
 	template<typename Elem>
 	inline auto binary_tree<Elem>::inorder_const_iterator::operator--()
 	{
-		this->index_--;
+		this->_step(false);
 		return *this;
 	}
 
@@ -1350,7 +1939,7 @@ namespace tvj
 	inline auto binary_tree<Elem>::inorder_const_iterator::operator++(int)
 	{
 		auto ret = *this;
-		this->index_++;
+		this->_step(true);
 		return ret;
 	}
 
@@ -1358,91 +1947,90 @@ namespace tvj
 	inline auto binary_tree<Elem>::inorder_const_iterator::operator--(int)
 	{
 		auto ret = *this;
-		this->index_--;
+		this->_step(false);
 		return ret;
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_const_iterator binary_tree<Elem>::inorder_const_iterator::operator+(long long n) const
 	{
-		return inorder_const_iterator(this->parent_tree_, static_cast<size_t>(static_cast<long long>(this->index_) + n));
+		return inorder_const_iterator(this->parent_tree_, this->order_, static_cast<size_t>(static_cast<long long>(this->_index()) + n));
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_const_iterator binary_tree<Elem>::inorder_const_iterator::operator-(long long n) const
 	{
-		return inorder_const_iterator(this->parent_tree_, static_cast<size_t>(static_cast<long long>(this->index_) - n));
+		return inorder_const_iterator(this->parent_tree_, this->order_, static_cast<size_t>(static_cast<long long>(this->_index()) - n));
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_const_iterator binary_tree<Elem>::inorder_const_iterator::operator+=(long long n)
 	{
-		this->index_ = static_cast<size_t>(static_cast<long long>(this->index_) + n);
+		this->_move_to(static_cast<size_t>(static_cast<long long>(this->_index()) + n));
 		return *this;
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_const_iterator binary_tree<Elem>::inorder_const_iterator::operator-=(long long n)
 	{
-		this->index_ = static_cast<size_t>(static_cast<long long>(this->index_) - n);
+		this->_move_to(static_cast<size_t>(static_cast<long long>(this->_index()) - n));
 		return *this;
 	}
 
 	template<typename Elem>
 	inline Elem& binary_tree<Elem>::inorder_iterator::operator*()
 	{
-		return this->sequence_[this->index_]->data_;
+		return this->node_->data_;
 	}
 
 	template<typename Elem>
 	inline Elem* binary_tree<Elem>::inorder_iterator::operator->()
 	{
-		return &this->sequence_[this->index_]->data_;
+		return &this->node_->data_;
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_iterator binary_tree<Elem>::inorder_iterator::operator+(long long n)
 	{
-		return inorder_iterator(this->parent_tree_, static_cast<size_t>(static_cast<long long>(this->index_) + n));
+		return inorder_iterator(this->parent_tree_, this->order_, static_cast<size_t>(static_cast<long long>(this->_index()) + n));
 	}
 
 	template<typename Elem>
 	inline typename binary_tree<Elem>::inorder_iterator binary_tree<Elem>::inorder_iterator::operator-(long long n)
 	{
-		return inorder_iterator(this->parent_tree_, static_cast<size_t>(static_cast<long long>(this->index_) - n));
+		return inorder_iterator(this->parent_tree_, this->order_, static_cast<size_t>(static_cast<long long>(this->_index()) - n));
 	}
 
 	template<typename Elem>
 	inline long long binary_tree<Elem>::inorder_iterator::operator-(const inorder_iterator& iter) const noexcept
 	{
-		return static_cast<long long>(this->index_) - static_cast<long long>(iter.index_);
+		return static_cast<long long>(this->_index()) - static_cast<long long>(iter._index());
 	}
 
 	template<typename Elem>
 	inline auto binary_tree<Elem>::inorder_const_iterator::operator-(const inorder_const_iterator& iter) const noexcept
 	{
-		return static_cast<long long>(this->index_) - static_cast<long long>(iter.index_);
+		return static_cast<long long>(this->_index()) - static_cast<long long>(iter._index());
 	}
 
 	template<typename Elem>
 	inline bool binary_tree<Elem>::inorder_const_iterator::operator==(const inorder_const_iterator& iter) const noexcept
 	{
-		return this->index_ == iter.index_ && this->sequence_ == iter.sequence_;
+		return this->node_ == iter.node_ && this->order_ == iter.order_;
 	}
 
 	template<typename Elem>
 	inline bool binary_tree<Elem>::inorder_const_iterator::operator!=(const inorder_const_iterator& iter) const noexcept
 	{
-		return this->index_ != iter.index_ || this->sequence_ != iter.sequence_;
+		return !(*this == iter);
 	}
 
 	template<typename Elem>
 	inline bool binary_tree<Elem>::inorder_const_iterator::operator<(const inorder_const_iterator& iter) const noexcept
 	{
-		return this->index_ < iter.index_;
+		return this->_index() < iter._index();
 	}
 
-#undef sequence_
 #undef cthis
 }
 
@@ -0,0 +1,441 @@
+/*
+ * File: TVJ_Bit_String.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_String.h 1.6
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include "TVJ_String.h"
+
+namespace tvj
+{
+	/**
+	 * brief: the number of leading zero bits
+	 * param: a non-zero 64-bit number
+	 * return: unsigned
+	 */
+	inline unsigned _leading_zero_count(uint64_t bits) noexcept
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index__;
+		_BitScanReverse64(&index__, bits);
+		return 63 - static_cast<unsigned>(index__);
+#elif defined(_MSC_VER)
+		unsigned count__ = 0;
+		while (!(bits & (1ull << 63)))
+		{
+			bits <<= 1;
+			count__++;
+		}
+		return count__;
+#else
+		return static_cast<unsigned>(__builtin_clzll(bits));
+#endif
+	}
+
+	// a sequence of bits packed into 64-bit words,
+	// bit i is stored in word i / 64 counting from the most significant bit,
+	// up to 64 bits are stored in place without dynamic allocation
+	class bit_string
+	{
+	public:
+
+		/**
+		 * brief: default constructor, an empty bit string
+		 * param: (void)
+		 * return: --
+		 */
+		bit_string();
+
+		/**
+		 * brief: constructor from the textual form
+		 * param: a string of '0' and '1'
+		 * return: --
+		 */
+		explicit bit_string(const string& text);
+
+		/**
+		 * brief: copy constructor
+		 * param: another bit string
+		 * return: --
+		 */
+		bit_string(const bit_string& bits);
+
+		/**
+		 * brief: destructor
+		 * param: (void)
+		 * return: --
+		 */
+		~bit_string();
+
+		/**
+		 * brief: copy
+		 * param: another bit string
+		 * return: bit_string (read & write)
+		 */
+		bit_string& operator=(const bit_string& bits);
+
+		/**
+		 * brief: the number of bits
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: check if there is no bit
+		 * param: (void)
+		 * return: bool
+		 */
+		bool empty() const noexcept;
+
+		/**
+		 * brief: remove all bits
+		 * param: (void)
+		 * return: void
+		 */
+		void clear() noexcept;
+
+		/**
+		 * brief: the bit at a certain index
+		 * param: the index
+		 * return: bool
+		 */
+		bool operator[](size_t index) const;
+
+		/**
+		 * brief: append a bit at the end
+		 * param: the bit
+		 * return: void
+		 */
+		void push_back(bool bit);
+
+		/**
+		 * brief: remove the last bit
+		 * param: (void)
+		 * return: void
+		 */
+		void pop_back();
+
+		/**
+		 * brief: append a run of bits at the end
+		 * param: the bits (the lowest count bits, the most significant of them first) and the count (at most 64)
+		 * return: bit_string (read & write)
+		 */
+		bit_string& append_bits(uint64_t bits, unsigned count);
+
+		/**
+		 * brief: append another bit string at the end
+		 * param: the bit string
+		 * return: bit_string (read & write)
+		 */
+		bit_string& append(const bit_string& bits);
+
+		/**
+		 * brief: the number of leading bits that are the same
+		 * param: another bit string
+		 * return: size_t
+		 */
+		size_t common_prefix(const bit_string& bits) const noexcept;
+
+		/**
+		 * brief: check if a bit string is the prefix of this
+		 * param: the prefix
+		 * return: bool
+		 */
+		bool starts_with(const bit_string& prefix) const noexcept;
+
+		/**
+		 * brief: the number of 64-bit words
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t word_count() const noexcept;
+
+		/**
+		 * brief: a 64-bit word, the unused bits of the last word are 0
+		 * param: the index of the word
+		 * return: uint64_t
+		 */
+		uint64_t word(size_t index) const;
+
+		/**
+		 * brief: the textual form
+		 * param: (void)
+		 * return: a string of '0' and '1'
+		 */
+		string to_string() const;
+
+		/**
+		 * brief: append the textual form to a string
+		 * param: the string
+		 * return: void
+		 */
+		void append_to(string& text) const;
+
+		bit_string& operator+=(const bit_string& bits);
+		bit_string operator+(const bit_string& bits) const;
+		bool operator==(const bit_string& bits) const noexcept;
+		bool operator!=(const bit_string& bits) const noexcept;
+
+	private:
+
+		/**
+		 * brief: append the leading bits of a word
+		 * param: the word (unused low bits must be 0) and the number of bits used
+		 * return: void
+		 */
+		void _append_word(uint64_t bits, unsigned count);
+
+		/**
+		 * brief: make sure there is room for a certain number of words
+		 * param: the number of words
+		 * return: void
+		 */
+		void _reserve(size_t words);
+
+		// the only word when there are at most 64 bits
+		uint64_t small_ = 0;
+
+		// the packed bits, the first (size_ + 63) / 64 words are used
+		// and the bits after size_ in the last used word are always 0
+		uint64_t* words_ = &small_;
+
+		// the number of words words_ can hold
+		size_t capacity_ = 1;
+
+		// the number of bits
+		size_t size_ = 0;
+	};
+
+	inline bit_string::bit_string() { }
+
+	inline bit_string::bit_string(const bit_string& bits)
+	{
+		*this = bits;
+	}
+
+	inline bit_string::~bit_string()
+	{
+		if (words_ != &small_) delete[] words_;
+		words_ = nullptr;
+	}
+
+	inline bit_string& bit_string::operator=(const bit_string& bits)
+	{
+		if (&bits == this) return *this;
+		const size_t words__ = bits.word_count();
+		_reserve(words__);
+		if (words__) memcpy(words_, bits.words_, words__ * sizeof(uint64_t));
+		size_ = bits.size_;
+		return *this;
+	}
+
+	inline bit_string::bit_string(const string& text)
+	{
+		for (const char& ch : text)
+		{
+#ifndef NDEBUG
+			if (ch != '0' && ch != '1') error_info("Not a bit in the constructor of tvj::bit_string", TVJ_STRING_TYPE_MISMATCH);
+#endif
+			push_back(ch == '1');
+		}
+	}
+
+	inline size_t bit_string::size() const noexcept
+	{
+		return size_;
+	}
+
+	inline bool bit_string::empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	inline void bit_string::clear() noexcept
+	{
+		size_ = 0;
+	}
+
+	inline bool bit_string::operator[](size_t index) const
+	{
+#ifndef NDEBUG
+		if (index >= size_) error_info("Overflow in operator[] of tvj::bit_string", TVJ_STRING_OVERFLOW);
+#endif
+		return (words_[index >> 6] >> (63 - (index & 63))) & 1;
+	}
+
+	inline void bit_string::push_back(bool bit)
+	{
+		_append_word(bit ? 1ull << 63 : 0, 1);
+	}
+
+	inline void bit_string::pop_back()
+	{
+#ifndef NDEBUG
+		if (size_ == 0) error_info("No bit to pop in pop_back of tvj::bit_string", TVJ_STRING_OVERFLOW);
+#endif
+		size_--;
+		words_[size_ >> 6] &= ~(1ull << (63 - (size_ & 63)));
+	}
+
+	inline bit_string& bit_string::append_bits(uint64_t bits, unsigned count)
+	{
+#ifndef NDEBUG
+		if (count > 64) error_info("More than 64 bits in append_bits of tvj::bit_string", TVJ_STRING_OVERFLOW);
+#endif
+		if (count) _append_word(bits << (64 - count), count);
+		return *this;
+	}
+
+	inline bit_string& bit_string::append(const bit_string& bits)
+	{
+		if (&bits == this)
+		{
+			const bit_string copy__ = bits;
+			return append(copy__);
+		}
+		const size_t words__ = bits.word_count();
+		for (size_t i = 0; i != words__; i++)
+		{
+			const size_t left__ = bits.size_ - (i << 6);
+			_append_word(bits.words_[i], left__ < 64 ? static_cast<unsigned>(left__) : 64);
+		}
+		return *this;
+	}
+
+	inline size_t bit_string::common_prefix(const bit_string& bits) const noexcept
+	{
+		const size_t length__ = size_ < bits.size_ ? size_ : bits.size_;
+		for (size_t i = 0; (i << 6) < length__; i++)
+		{
+			const uint64_t diff__ = words_[i] ^ bits.words_[i];
+			if (diff__)
+			{
+				const size_t common__ = (i << 6) + _leading_zero_count(diff__);
+				return common__ < length__ ? common__ : length__;
+			}
+		}
+		return length__;
+	}
+
+	inline bool bit_string::starts_with(const bit_string& prefix) const noexcept
+	{
+		return prefix.size_ <= size_ && common_prefix(prefix) == prefix.size_;
+	}
+
+	inline size_t bit_string::word_count() const noexcept
+	{
+		return (size_ + 63) >> 6;
+	}
+
+	inline uint64_t bit_string::word(size_t index) const
+	{
+#ifndef NDEBUG
+		if (index >= word_count()) error_info("Overflow in word of tvj::bit_string", TVJ_STRING_OVERFLOW);
+#endif
+		return words_[index];
+	}
+
+	inline string bit_string::to_string() const
+	{
+		string ret;
+		append_to(ret);
+		return ret;
+	}
+
+	inline void bit_string::append_to(string& text) const
+	{
+		text.reserve(text.size() + size_);
+		for (size_t i = 0; i != size_; i++)
+		{
+			text.append((*this)[i] ? '1' : '0');
+		}
+	}
+
+	inline bit_string& bit_string::operator+=(const bit_string& bits)
+	{
+		return append(bits);
+	}
+
+	inline bit_string bit_string::operator+(const bit_string& bits) const
+	{
+		bit_string ret = *this;
+		ret.append(bits);
+		return ret;
+	}
+
+	inline bool bit_string::operator==(const bit_string& bits) const noexcept
+	{
+		if (size_ != bits.size_) return false;
+		for (size_t i = 0; i != word_count(); i++)
+		{
+			if (words_[i] != bits.words_[i]) return false;
+		}
+		return true;
+	}
+
+	inline bool bit_string::operator!=(const bit_string& bits) const noexcept
+	{
+		return !(*this == bits);
+	}
+
+	inline void bit_string::_append_word(uint64_t bits, unsigned count)
+	{
+		const unsigned used__ = static_cast<unsigned>(size_ & 63);
+		const size_t words__ = word_count();
+		if (used__ == 0)
+		{
+			_reserve(words__ + 1);
+			words_[words__] = bits;
+		}
+		else
+		{
+			words_[words__ - 1] |= bits >> used__;
+			if (used__ + count > 64)
+			{
+				_reserve(words__ + 1);
+				words_[words__] = bits << (64 - used__);
+			}
+		}
+		size_ += count;
+	}
+
+	inline void bit_string::_reserve(size_t words)
+	{
+		if (words <= capacity_) return;
+		size_t capacity__ = capacity_ << 1;
+		if (capacity__ < words) capacity__ = words;
+		uint64_t* words__ = new uint64_t[capacity__];
+		memcpy(words__, words_, word_count() * sizeof(uint64_t));
+		if (words_ != &small_) delete[] words_;
+		words_ = words__;
+		capacity_ = capacity__;
+	}
+
+	inline std::ostream& operator<<(std::ostream& out, const bit_string& bits)
+	{
+		for (size_t i = 0; i != bits.size(); i++)
+		{
+			out << (bits[i] ? '1' : '0');
+		}
+		return out;
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
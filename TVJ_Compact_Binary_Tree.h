@@ -0,0 +1,1087 @@
+/*
+ * File: TVJ_Compact_Binary_Tree.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ *
+ * @version 1.1 2026/10/18
+ * - fix inserting the data of a node of the same tree when the array grows
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace tvj
+{
+#define COMPACT_BT_NIL 0xFFFFFFFFu    // the index of no node
+#define COMPACT_BT_FIRST_CAPACITY 32  // the number of nodes the first array holds, each next one is twice as large
+
+	// define TVJ_COMPACT_BT_SPLIT before including this file to keep the links and the data in two arrays,
+	// then a traversal only reads the links (12 bytes a node) and the data is touched when it is dereferenced
+
+	// a binary tree with the navigation of binary_tree whose nodes live in one array and are linked by 32-bit indices,
+	// so a node takes 12 bytes besides its data (instead of three pointers and a weight),
+	// the node 0 is the parent of the root and the end of the iterators,
+	// the room of a removed node is reused, and iterators hold indices, so they stay valid when the array grows
+	template<typename Elem>
+	class compact_binary_tree
+	{
+	public:
+		enum Traversal_Order { PREORDER, INORDER, POSTORDER };
+
+	protected:
+		struct _links
+		{
+			uint32_t parent_, L_child_, R_child_;
+		};
+
+#ifndef TVJ_COMPACT_BT_SPLIT
+		struct _node : _links
+		{
+			Elem data_;
+		};
+#endif
+
+		/**
+		 * brief: the links of a node
+		 * param: the index
+		 * return: _links (read & write)
+		 */
+		_links& _link(uint32_t node) noexcept;
+		const _links& _link(uint32_t node) const noexcept;
+
+		/**
+		 * brief: the data of a node
+		 * param: the index
+		 * return: Elem (read & write)
+		 */
+		Elem& _data(uint32_t node) noexcept;
+		const Elem& _data(uint32_t node) const noexcept;
+
+		/**
+		 * brief: take the room of a removed node or the next free one
+		 * param: the parent and the data (taken by value as it may be in the array that moves)
+		 * return: the index
+		 */
+		uint32_t _new_node(uint32_t parent, Elem data);
+
+		/**
+		 * brief: move the nodes into arrays of a larger capacity
+		 * param: the capacity
+		 * return: void
+		 */
+		void _reallocate(uint32_t capacity);
+
+		/**
+		 * brief: the first node in a certain order (the end if the tree is empty)
+		 * param: the order
+		 * return: the index
+		 */
+		uint32_t _first(Traversal_Order order) const noexcept;
+
+		/**
+		 * brief: the node after another in a certain order (the end stays the end)
+		 * param: the order and the node
+		 * return: the index
+		 */
+		uint32_t _next(Traversal_Order order, uint32_t node) const noexcept;
+
+		/**
+		 * brief: the node before another in a certain order (COMPACT_BT_NIL before the first)
+		 * param: the order and the node
+		 * return: the index
+		 */
+		uint32_t _previous(Traversal_Order order, uint32_t node) const noexcept;
+
+#ifdef TVJ_COMPACT_BT_SPLIT
+		_links* links_ = nullptr;
+		Elem* data_ = nullptr;
+#else
+		_node* nodes_ = nullptr;
+#endif
+
+		// the number of nodes ever taken from the array (the node 0 included) and the room of it
+		uint32_t used_ = 0;
+		uint32_t capacity_ = 0;
+
+		// the removed nodes, linked by their parent_
+		uint32_t free_ = COMPACT_BT_NIL;
+
+		size_t size_ = 0;
+
+	public:
+		class const_iterator
+		{
+			friend class compact_binary_tree;
+
+		public:
+			// constructor
+			const_iterator() = default;
+
+		protected:
+			const_iterator(const compact_binary_tree* tree, Traversal_Order order, uint32_t node) noexcept;
+
+		public:
+			// @ functions providing limited access
+			const Elem& operator* () const;
+			const Elem* operator->() const;
+			const_iterator& operator++() noexcept;
+			const_iterator& operator--() noexcept;
+			const_iterator operator++(int) noexcept;
+			const_iterator operator--(int) noexcept;
+			bool operator==(const const_iterator& iter) const noexcept;
+			bool operator!=(const const_iterator& iter) const noexcept;
+
+			bool is_root() const noexcept;
+			bool is_leaf() const noexcept;
+			bool is_parent() const noexcept;
+			bool is_left_child() const noexcept;
+			bool is_right_child() const noexcept;
+			bool is_before_begin() const noexcept;
+			bool has_left_child() const noexcept;
+			bool has_right_child() const noexcept;
+
+			size_t degree() const noexcept;
+
+			const_iterator parent() const noexcept;
+			const_iterator left_child() const noexcept;
+			const_iterator right_child() const noexcept;
+			const_iterator sibling() const noexcept;
+
+			/**
+			 * brief: the index of the node in the array, which does not change until the node is removed
+			 * param: (void)
+			 * return: uint32_t
+			 */
+			uint32_t index() const noexcept;
+
+		protected:
+			compact_binary_tree* tree_ = nullptr;
+
+			Traversal_Order order_ = INORDER;
+
+			// the node, 0 at the end and COMPACT_BT_NIL before the beginning
+			uint32_t node_ = COMPACT_BT_NIL;
+		};
+
+		class iterator : public const_iterator
+		{
+			friend class compact_binary_tree;
+
+		public:
+			// constructor
+			iterator() = default;
+
+		protected:
+			iterator(compact_binary_tree* tree, Traversal_Order order, uint32_t node) noexcept;
+
+		public:
+			// @limited access
+			Elem& operator*();
+			Elem* operator->();
+			iterator& operator++() noexcept;
+			iterator& operator--() noexcept;
+			iterator operator++(int) noexcept;
+			iterator operator--(int) noexcept;
+
+			iterator parent() noexcept;
+			iterator left_child() noexcept;
+			iterator right_child() noexcept;
+			iterator sibling() noexcept;
+
+			iterator set_left_child(const Elem& data);
+			iterator set_right_child(const Elem& data);
+		};
+
+		using inorder_const_iterator = const_iterator;
+		using inorder_iterator = iterator;
+		using preorder_const_iterator = const_iterator;
+		using preorder_iterator = iterator;
+		using postorder_const_iterator = const_iterator;
+		using postorder_iterator = iterator;
+
+	public:
+
+		// constructor
+		compact_binary_tree();
+
+		// copy constructor
+		compact_binary_tree(const compact_binary_tree& tree);
+
+		compact_binary_tree(compact_binary_tree&& tree);
+
+		compact_binary_tree& operator=(compact_binary_tree tree) noexcept;
+
+		~compact_binary_tree();
+
+		/**
+		 * brief: exchange the nodes with another tree
+		 * param: the other tree
+		 * return: void
+		 */
+		void swap(compact_binary_tree& tree) noexcept;
+
+		size_t size() const noexcept;
+
+		/**
+		 * brief: the number of nodes the array holds without growing
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t capacity() const noexcept;
+
+		/**
+		 * brief: make room for a number of nodes at once
+		 * param: the number of nodes
+		 * return: void
+		 */
+		void reserve(size_t size);
+
+		/**
+		 * brief: remove a node, a node with two children takes the data of its inorder predecessor,
+		 *        which is removed instead (the iterators of the removed node are no longer valid)
+		 * param: the iterator of the node
+		 * return: void
+		 */
+		void remove(const const_iterator& iter);
+
+		/**
+		 * brief: remove all the nodes (the room is kept)
+		 * param: (void)
+		 * return: void
+		 */
+		void clear() noexcept;
+
+		// @inorder_iterator
+		const_iterator inorder_croot() const noexcept;
+		const_iterator inorder_cbegin() const noexcept;
+		const_iterator inorder_cend() const noexcept;
+		iterator inorder_root() noexcept;
+		iterator inorder_begin() noexcept;
+		iterator inorder_end() noexcept;
+
+		// @preorder_iterator
+		const_iterator preorder_croot() const noexcept;
+		const_iterator preorder_cbegin() const noexcept;
+		const_iterator preorder_cend() const noexcept;
+		iterator preorder_root() noexcept;
+		iterator preorder_begin() noexcept;
+		iterator preorder_end() noexcept;
+
+		// @postorder_iterator
+		const_iterator postorder_croot() const noexcept;
+		const_iterator postorder_cbegin() const noexcept;
+		const_iterator postorder_cend() const noexcept;
+		iterator postorder_root() noexcept;
+		iterator postorder_begin() noexcept;
+		iterator postorder_end() noexcept;
+
+		// @iterator
+		const_iterator croot() const noexcept;
+		const_iterator cbegin() const noexcept;
+		const_iterator cend() const noexcept;
+		const_iterator root() const noexcept;
+		const_iterator begin() const noexcept;
+		const_iterator end() const noexcept;
+		iterator root() noexcept;
+		iterator begin() noexcept;
+		iterator end() noexcept;
+		iterator set_root(const Elem& data);
+
+	protected:
+		/**
+		 * brief: a const_iterator at a node
+		 * param: the order and the node
+		 * return: const_iterator
+		 */
+		const_iterator _const_iterator(Traversal_Order order, uint32_t node) const noexcept;
+	};
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::_links& compact_binary_tree<Elem>::_link(uint32_t node) noexcept
+	{
+#ifdef TVJ_COMPACT_BT_SPLIT
+		return links_[node];
+#else
+		return nodes_[node];
+#endif
+	}
+
+	template<typename Elem>
+	inline const typename compact_binary_tree<Elem>::_links& compact_binary_tree<Elem>::_link(uint32_t node) const noexcept
+	{
+#ifdef TVJ_COMPACT_BT_SPLIT
+		return links_[node];
+#else
+		return nodes_[node];
+#endif
+	}
+
+	template<typename Elem>
+	inline Elem& compact_binary_tree<Elem>::_data(uint32_t node) noexcept
+	{
+#ifdef TVJ_COMPACT_BT_SPLIT
+		return data_[node];
+#else
+		return nodes_[node].data_;
+#endif
+	}
+
+	template<typename Elem>
+	inline const Elem& compact_binary_tree<Elem>::_data(uint32_t node) const noexcept
+	{
+#ifdef TVJ_COMPACT_BT_SPLIT
+		return data_[node];
+#else
+		return nodes_[node].data_;
+#endif
+	}
+
+	template<typename Elem>
+	inline uint32_t compact_binary_tree<Elem>::_new_node(uint32_t parent, Elem data)
+	{
+		uint32_t node__ = free_;
+		if (node__ != COMPACT_BT_NIL)
+		{
+			free_ = _link(node__).parent_;
+		}
+		else
+		{
+			if (used_ == capacity_)
+			{
+				if (capacity_ == COMPACT_BT_NIL) throw std::overflow_error("Too many nodes in tvj::compact_binary_tree.");
+				_reallocate(capacity_ > COMPACT_BT_NIL / 2 ? COMPACT_BT_NIL : capacity_ * 2);
+			}
+			node__ = used_++;
+		}
+		_data(node__) = std::move(data);
+		_links& links__ = _link(node__);
+		links__.parent_ = parent;
+		links__.L_child_ = links__.R_child_ = COMPACT_BT_NIL;
+		size_++;
+		return node__;
+	}
+
+	template<typename Elem>
+	inline void compact_binary_tree<Elem>::_reallocate(uint32_t capacity)
+	{
+#ifdef TVJ_COMPACT_BT_SPLIT
+		_links* links__ = new _links[capacity];
+		Elem* data__;
+		try
+		{
+			data__ = new Elem[capacity];
+		}
+		catch (...)
+		{
+			delete[] links__;
+			throw;
+		}
+		for (uint32_t i = 0; i != used_; i++)
+		{
+			links__[i] = links_[i];
+			data__[i] = std::move(data_[i]);
+		}
+		delete[] links_;
+		delete[] data_;
+		links_ = links__;
+		data_ = data__;
+#else
+		_node* nodes__ = new _node[capacity];
+		for (uint32_t i = 0; i != used_; i++) nodes__[i] = std::move(nodes_[i]);
+		delete[] nodes_;
+		nodes_ = nodes__;
+#endif
+		capacity_ = capacity;
+	}
+
+	template<typename Elem>
+	inline uint32_t compact_binary_tree<Elem>::_first(Traversal_Order order) const noexcept
+	{
+		uint32_t p__ = _link(0).L_child_;
+		if (p__ == COMPACT_BT_NIL) return 0;
+		if (order == INORDER)
+		{
+			while (_link(p__).L_child_ != COMPACT_BT_NIL) p__ = _link(p__).L_child_;
+		}
+		else if (order == POSTORDER)
+		{
+			for (;;)
+			{
+				const _links& links__ = _link(p__);
+				if (links__.L_child_ != COMPACT_BT_NIL) p__ = links__.L_child_;
+				else if (links__.R_child_ != COMPACT_BT_NIL) p__ = links__.R_child_;
+				else break;
+			}
+		}
+		return p__;
+	}
+
+	template<typename Elem>
+	inline uint32_t compact_binary_tree<Elem>::_next(Traversal_Order order, uint32_t node) const noexcept
+	{
+		if (node == 0) return 0;
+		switch (order)
+		{
+		case PREORDER:
+			if (_link(node).L_child_ != COMPACT_BT_NIL) return _link(node).L_child_;
+			if (_link(node).R_child_ != COMPACT_BT_NIL) return _link(node).R_child_;
+			// up to the first ancestor entered from the left with a right subtree
+			for (; node != 0; node = _link(node).parent_)
+			{
+				const _links& parent__ = _link(_link(node).parent_);
+				if (parent__.L_child_ == node && parent__.R_child_ != COMPACT_BT_NIL) return parent__.R_child_;
+			}
+			return 0;
+		case POSTORDER:
+		{
+			const uint32_t parent__ = _link(node).parent_;
+			if (_link(parent__).L_child_ == node && _link(parent__).R_child_ != COMPACT_BT_NIL)
+			{
+				// the first node of the right sibling subtree
+				node = _link(parent__).R_child_;
+				for (;;)
+				{
+					const _links& links__ = _link(node);
+					if (links__.L_child_ != COMPACT_BT_NIL) node = links__.L_child_;
+					else if (links__.R_child_ != COMPACT_BT_NIL) node = links__.R_child_;
+					else return node;
+				}
+			}
+			return parent__; // the parent of the root is the end
+		}
+		default:
+			if (_link(node).R_child_ != COMPACT_BT_NIL)
+			{
+				node = _link(node).R_child_;
+				while (_link(node).L_child_ != COMPACT_BT_NIL) node = _link(node).L_child_;
+				return node;
+			}
+			// the root is the left child of the end, so the last node goes up to it
+			while (_link(_link(node).parent_).R_child_ == node) node = _link(node).parent_;
+			return _link(node).parent_;
+		}
+	}
+
+	template<typename Elem>
+	inline uint32_t compact_binary_tree<Elem>::_previous(Traversal_Order order, uint32_t node) const noexcept
+	{
+		if (node == COMPACT_BT_NIL) return COMPACT_BT_NIL;
+		switch (order)
+		{
+		case PREORDER:
+		{
+			const uint32_t parent__ = _link(node).parent_;
+			if (node == 0 || (_link(parent__).R_child_ == node && _link(parent__).L_child_ != COMPACT_BT_NIL))
+			{
+				// the last node of the left sibling subtree (of the whole tree from the end)
+				node = node == 0 ? _link(0).L_child_ : _link(parent__).L_child_;
+				while (node != COMPACT_BT_NIL)
+				{
+					const _links& links__ = _link(node);
+					if (links__.R_child_ != COMPACT_BT_NIL) node = links__.R_child_;
+					else if (links__.L_child_ != COMPACT_BT_NIL) node = links__.L_child_;
+					else break;
+				}
+				return node;
+			}
+			return parent__ == 0 ? COMPACT_BT_NIL : parent__;
+		}
+		case POSTORDER:
+			if (_link(node).R_child_ != COMPACT_BT_NIL) return _link(node).R_child_;
+			if (_link(node).L_child_ != COMPACT_BT_NIL) return _link(node).L_child_;
+			if (node == 0) return COMPACT_BT_NIL;
+			// up to the first ancestor entered from the right with a left subtree
+			for (; _link(node).parent_ != 0; node = _link(node).parent_)
+			{
+				const _links& parent__ = _link(_link(node).parent_);
+				if (parent__.R_child_ == node && parent__.L_child_ != COMPACT_BT_NIL) return parent__.L_child_;
+			}
+			return COMPACT_BT_NIL;
+		default:
+			if (_link(node).L_child_ != COMPACT_BT_NIL)
+			{
+				node = _link(node).L_child_;
+				while (_link(node).R_child_ != COMPACT_BT_NIL) node = _link(node).R_child_;
+				return node;
+			}
+			while (node != 0 && _link(_link(node).parent_).L_child_ == node) node = _link(node).parent_;
+			return node == 0 ? COMPACT_BT_NIL : _link(node).parent_;
+		}
+	}
+
+	template<typename Elem>
+	inline compact_binary_tree<Elem>::compact_binary_tree()
+	{
+		_reallocate(COMPACT_BT_FIRST_CAPACITY);
+		_links& end__ = _link(0);
+		end__.parent_ = end__.L_child_ = end__.R_child_ = COMPACT_BT_NIL;
+		used_ = 1;
+	}
+
+	template<typename Elem>
+	inline compact_binary_tree<Elem>::compact_binary_tree(const compact_binary_tree& tree)
+	{
+		// the indices stay the same, so the arrays are copied as they are
+		_reallocate(tree.used_);
+		for (uint32_t i = 0; i != tree.used_; i++)
+		{
+			_link(i) = tree._link(i);
+			_data(i) = tree._data(i);
+		}
+		used_ = tree.used_;
+		free_ = tree.free_;
+		size_ = tree.size_;
+	}
+
+	template<typename Elem>
+	inline compact_binary_tree<Elem>::compact_binary_tree(compact_binary_tree&& tree)
+		: compact_binary_tree()
+	{
+		swap(tree);
+	}
+
+	template<typename Elem>
+	inline compact_binary_tree<Elem>& compact_binary_tree<Elem>::operator=(compact_binary_tree tree) noexcept
+	{
+		swap(tree);
+		return *this;
+	}
+
+	template<typename Elem>
+	inline compact_binary_tree<Elem>::~compact_binary_tree()
+	{
+#ifdef TVJ_COMPACT_BT_SPLIT
+		delete[] links_;
+		delete[] data_;
+#else
+		delete[] nodes_;
+#endif
+	}
+
+	template<typename Elem>
+	inline void compact_binary_tree<Elem>::swap(compact_binary_tree& tree) noexcept
+	{
+#ifdef TVJ_COMPACT_BT_SPLIT
+		std::swap(links_, tree.links_);
+		std::swap(data_, tree.data_);
+#else
+		std::swap(nodes_, tree.nodes_);
+#endif
+		std::swap(used_, tree.used_);
+		std::swap(capacity_, tree.capacity_);
+		std::swap(free_, tree.free_);
+		std::swap(size_, tree.size_);
+	}
+
+	template<typename Elem>
+	inline size_t compact_binary_tree<Elem>::size() const noexcept
+	{
+		return size_;
+	}
+
+	template<typename Elem>
+	inline size_t compact_binary_tree<Elem>::capacity() const noexcept
+	{
+		return capacity_ - 1; // the node 0 is not counted
+	}
+
+	template<typename Elem>
+	inline void compact_binary_tree<Elem>::reserve(size_t size)
+	{
+		if (size >= COMPACT_BT_NIL) throw std::overflow_error("Too many nodes reserved in tvj::compact_binary_tree.");
+		if (size + 1 > capacity_) _reallocate(static_cast<uint32_t>(size + 1));
+	}
+
+	template<typename Elem>
+	inline void compact_binary_tree<Elem>::remove(const const_iterator& iter)
+	{
+		uint32_t node__ = iter.node_;
+#ifndef NDEBUG
+		if (node__ == 0 || node__ == COMPACT_BT_NIL) throw std::out_of_range("Remove no node from tvj::compact_binary_tree.");
+#endif
+		if (_link(node__).L_child_ != COMPACT_BT_NIL && _link(node__).R_child_ != COMPACT_BT_NIL)
+		{
+			// take the data of the inorder predecessor, which has no right child, and remove that node instead
+			uint32_t previous__ = _link(node__).L_child_;
+			while (_link(previous__).R_child_ != COMPACT_BT_NIL) previous__ = _link(previous__).R_child_;
+			_data(node__) = std::move(_data(previous__));
+			node__ = previous__;
+		}
+		const _links links__ = _link(node__);
+		const uint32_t child__ = links__.L_child_ != COMPACT_BT_NIL ? links__.L_child_ : links__.R_child_;
+		if (child__ != COMPACT_BT_NIL) _link(child__).parent_ = links__.parent_;
+		_links& parent__ = _link(links__.parent_);
+		if (parent__.L_child_ == node__)
+		{
+			parent__.L_child_ = child__;
+		}
+		else
+		{
+			parent__.R_child_ = child__;
+		}
+		_data(node__) = Elem(); // let the data free what it holds
+		_link(node__).parent_ = free_;
+		free_ = node__;
+		size_--;
+	}
+
+	template<typename Elem>
+	inline void compact_binary_tree<Elem>::clear() noexcept
+	{
+		if (!std::is_trivially_destructible<Elem>::value)
+		{
+			for (uint32_t i = 1; i != used_; i++) _data(i) = Elem();
+		}
+		_link(0).L_child_ = COMPACT_BT_NIL;
+		used_ = 1;
+		free_ = COMPACT_BT_NIL;
+		size_ = 0;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::inorder_croot() const noexcept
+	{
+		return const_iterator(this, INORDER, _link(0).L_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::inorder_cbegin() const noexcept
+	{
+		return const_iterator(this, INORDER, _first(INORDER));
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::inorder_cend() const noexcept
+	{
+		return const_iterator(this, INORDER, 0);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::inorder_root() noexcept
+	{
+		return iterator(this, INORDER, _link(0).L_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::inorder_begin() noexcept
+	{
+		return iterator(this, INORDER, _first(INORDER));
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::inorder_end() noexcept
+	{
+		return iterator(this, INORDER, 0);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::preorder_croot() const noexcept
+	{
+		return const_iterator(this, PREORDER, _link(0).L_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::preorder_cbegin() const noexcept
+	{
+		return const_iterator(this, PREORDER, _first(PREORDER));
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::preorder_cend() const noexcept
+	{
+		return const_iterator(this, PREORDER, 0);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::preorder_root() noexcept
+	{
+		return iterator(this, PREORDER, _link(0).L_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::preorder_begin() noexcept
+	{
+		return iterator(this, PREORDER, _first(PREORDER));
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::preorder_end() noexcept
+	{
+		return iterator(this, PREORDER, 0);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::postorder_croot() const noexcept
+	{
+		return const_iterator(this, POSTORDER, _link(0).L_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::postorder_cbegin() const noexcept
+	{
+		return const_iterator(this, POSTORDER, _first(POSTORDER));
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::postorder_cend() const noexcept
+	{
+		return const_iterator(this, POSTORDER, 0);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::postorder_root() noexcept
+	{
+		return iterator(this, POSTORDER, _link(0).L_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::postorder_begin() noexcept
+	{
+		return iterator(this, POSTORDER, _first(POSTORDER));
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::postorder_end() noexcept
+	{
+		return iterator(this, POSTORDER, 0);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::croot() const noexcept
+	{
+		return inorder_croot();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::cbegin() const noexcept
+	{
+		return inorder_cbegin();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::cend() const noexcept
+	{
+		return inorder_cend();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::root() const noexcept
+	{
+		return inorder_croot();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::begin() const noexcept
+	{
+		return inorder_cbegin();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::end() const noexcept
+	{
+		return inorder_cend();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::root() noexcept
+	{
+		return inorder_root();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::begin() noexcept
+	{
+		return inorder_begin();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::end() noexcept
+	{
+		return inorder_end();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::set_root(const Elem& data)
+	{
+		if (_link(0).L_child_ != COMPACT_BT_NIL)
+		{
+			_data(_link(0).L_child_) = data;
+		}
+		else
+		{
+			const uint32_t node__ = _new_node(0, data);
+			_link(0).L_child_ = node__;
+		}
+		return root();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::_const_iterator(Traversal_Order order, uint32_t node) const noexcept
+	{
+		return const_iterator(this, order, node);
+	}
+
+	template<typename Elem>
+	inline compact_binary_tree<Elem>::const_iterator::const_iterator(const compact_binary_tree* tree, Traversal_Order order, uint32_t node) noexcept
+		: tree_(const_cast<compact_binary_tree*>(tree)), order_(order), node_(node) { }
+
+	template<typename Elem>
+	inline const Elem& compact_binary_tree<Elem>::const_iterator::operator*() const
+	{
+#ifndef NDEBUG
+		if (node_ == 0 || node_ == COMPACT_BT_NIL) throw std::out_of_range("Dereference no node of tvj::compact_binary_tree.");
+#endif
+		return tree_->_data(node_);
+	}
+
+	template<typename Elem>
+	inline const Elem* compact_binary_tree<Elem>::const_iterator::operator->() const
+	{
+		return &**this;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator& compact_binary_tree<Elem>::const_iterator::operator++() noexcept
+	{
+		node_ = node_ == COMPACT_BT_NIL ? tree_->_first(order_) : tree_->_next(order_, node_);
+		return *this;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator& compact_binary_tree<Elem>::const_iterator::operator--() noexcept
+	{
+		node_ = tree_->_previous(order_, node_);
+		return *this;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::const_iterator::operator++(int) noexcept
+	{
+		const_iterator ret = *this;
+		++*this;
+		return ret;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::const_iterator::operator--(int) noexcept
+	{
+		const_iterator ret = *this;
+		--*this;
+		return ret;
+	}
+
+	template<typename Elem>
+	inline bool compact_binary_tree<Elem>::const_iterator::operator==(const const_iterator& iter) const noexcept
+	{
+		return node_ == iter.node_ && tree_ == iter.tree_ && order_ == iter.order_;
+	}
+
+	template<typename Elem>
+	inline bool compact_binary_tree<Elem>::const_iterator::operator!=(const const_iterator& iter) const noexcept
+	{
+		return !(*this == iter);
+	}
+
+	template<typename Elem>
+	inline bool compact_binary_tree<Elem>::const_iterator::is_root() const noexcept
+	{
+		return node_ != COMPACT_BT_NIL && node_ != 0 && tree_->_link(node_).parent_ == 0;
+	}
+
+	template<typename Elem>
+	inline bool compact_binary_tree<Elem>::const_iterator::is_leaf() const noexcept
+	{
+		return degree() == 0;
+	}
+
+	template<typename Elem>
+	inline bool compact_binary_tree<Elem>::const_iterator::is_parent() const noexcept
+	{
+		return degree() != 0;
+	}
+
+	template<typename Elem>
+	inline bool compact_binary_tree<Elem>::const_iterator::is_left_child() const noexcept
+	{
+		return !is_root() && tree_->_link(tree_->_link(node_).parent_).L_child_ == node_;
+	}
+
+	template<typename Elem>
+	inline bool compact_binary_tree<Elem>::const_iterator::is_right_child() const noexcept
+	{
+		return !is_root() && tree_->_link(tree_->_link(node_).parent_).R_child_ == node_;
+	}
+
+	template<typename Elem>
+	inline bool compact_binary_tree<Elem>::const_iterator::is_before_begin() const noexcept
+	{
+		return node_ == COMPACT_BT_NIL;
+	}
+
+	template<typename Elem>
+	inline bool compact_binary_tree<Elem>::const_iterator::has_left_child() const noexcept
+	{
+		return tree_->_link(node_).L_child_ != COMPACT_BT_NIL;
+	}
+
+	template<typename Elem>
+	inline bool compact_binary_tree<Elem>::const_iterator::has_right_child() const noexcept
+	{
+		return tree_->_link(node_).R_child_ != COMPACT_BT_NIL;
+	}
+
+	template<typename Elem>
+	inline size_t compact_binary_tree<Elem>::const_iterator::degree() const noexcept
+	{
+		return has_left_child() + has_right_child();
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::const_iterator::parent() const noexcept
+	{
+		return const_iterator(tree_, order_, tree_->_link(node_).parent_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::const_iterator::left_child() const noexcept
+	{
+		return const_iterator(tree_, order_, tree_->_link(node_).L_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::const_iterator::right_child() const noexcept
+	{
+		return const_iterator(tree_, order_, tree_->_link(node_).R_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::const_iterator compact_binary_tree<Elem>::const_iterator::sibling() const noexcept
+	{
+		const _links& parent__ = tree_->_link(tree_->_link(node_).parent_);
+		return const_iterator(tree_, order_, parent__.L_child_ == node_ ? parent__.R_child_ : parent__.L_child_);
+	}
+
+	template<typename Elem>
+	inline uint32_t compact_binary_tree<Elem>::const_iterator::index() const noexcept
+	{
+		return node_;
+	}
+
+	template<typename Elem>
+	inline compact_binary_tree<Elem>::iterator::iterator(compact_binary_tree* tree, Traversal_Order order, uint32_t node) noexcept
+		: const_iterator(tree, order, node) { }
+
+	template<typename Elem>
+	inline Elem& compact_binary_tree<Elem>::iterator::operator*()
+	{
+		return const_cast<Elem&>(const_iterator::operator*());
+	}
+
+	template<typename Elem>
+	inline Elem* compact_binary_tree<Elem>::iterator::operator->()
+	{
+		return &**this;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator& compact_binary_tree<Elem>::iterator::operator++() noexcept
+	{
+		const_iterator::operator++();
+		return *this;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator& compact_binary_tree<Elem>::iterator::operator--() noexcept
+	{
+		const_iterator::operator--();
+		return *this;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::iterator::operator++(int) noexcept
+	{
+		iterator ret = *this;
+		++*this;
+		return ret;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::iterator::operator--(int) noexcept
+	{
+		iterator ret = *this;
+		--*this;
+		return ret;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::iterator::parent() noexcept
+	{
+		return iterator(this->tree_, this->order_, this->tree_->_link(this->node_).parent_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::iterator::left_child() noexcept
+	{
+		return iterator(this->tree_, this->order_, this->tree_->_link(this->node_).L_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::iterator::right_child() noexcept
+	{
+		return iterator(this->tree_, this->order_, this->tree_->_link(this->node_).R_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::iterator::sibling() noexcept
+	{
+		const _links& parent__ = this->tree_->_link(this->tree_->_link(this->node_).parent_);
+		return iterator(this->tree_, this->order_, parent__.L_child_ == this->node_ ? parent__.R_child_ : parent__.L_child_);
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::iterator::set_left_child(const Elem& data)
+	{
+		const uint32_t child__ = this->tree_->_link(this->node_).L_child_;
+		if (child__ != COMPACT_BT_NIL)
+		{
+			this->tree_->_data(child__) = data;
+		}
+		else
+		{
+			// the array may move here, so the links are looked up again
+			const uint32_t node__ = this->tree_->_new_node(this->node_, data);
+			this->tree_->_link(this->node_).L_child_ = node__;
+		}
+		return *this;
+	}
+
+	template<typename Elem>
+	inline typename compact_binary_tree<Elem>::iterator compact_binary_tree<Elem>::iterator::set_right_child(const Elem& data)
+	{
+		const uint32_t child__ = this->tree_->_link(this->node_).R_child_;
+		if (child__ != COMPACT_BT_NIL)
+		{
+			this->tree_->_data(child__) = data;
+		}
+		else
+		{
+			const uint32_t node__ = this->tree_->_new_node(this->node_, data);
+			this->tree_->_link(this->node_).R_child_ = node__;
+		}
+		return *this;
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
@@ -0,0 +1,243 @@
+/*
+ * File: TVJ_Concurrent_Stack.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#ifdef _MSC_VER
+#include <intrin.h> // _BitScanReverse
+#endif
+
+namespace tvj
+{
+#define CONCURRENT_STACK_FIRST_BLOCK 64   // the size of the first node block, each next one is twice as large
+#define CONCURRENT_STACK_NIL 0xFFFFFFFFu  // the index of no node
+
+	/**
+	 * brief: the index of the highest set bit
+	 * param: a non-zero number
+	 * return: unsigned
+	 */
+	inline unsigned _highest_bit_index(uint32_t value) noexcept
+	{
+#ifdef _MSC_VER
+		unsigned long index__;
+		_BitScanReverse(&index__, value);
+		return static_cast<unsigned>(index__);
+#else
+		return 31 - static_cast<unsigned>(__builtin_clz(value));
+#endif
+	}
+
+	// a lock-free stack (Treiber) that can be pushed and popped by any number of threads,
+	// nodes live in blocks that are never freed before the stack itself,
+	// and the head is a 32-bit node index with a 32-bit tag changed on every update,
+	// so that a node popped and pushed again in between (the ABA problem) is never mistaken
+	template<typename Elem>
+	class concurrent_stack
+	{
+	public:
+
+		/**
+		 * brief: default constructor
+		 * param: (void)
+		 * return: --
+		 */
+		concurrent_stack();
+
+		concurrent_stack(const concurrent_stack&) = delete;
+		concurrent_stack& operator=(const concurrent_stack&) = delete;
+
+		/**
+		 * brief: destructor (no other thread may be using the stack)
+		 * param: (void)
+		 * return: --
+		 */
+		~concurrent_stack();
+
+		/**
+		 * brief: push an element (copied / moved in)
+		 * param: the element
+		 * return: void
+		 */
+		void push(const Elem& elem);
+		void push(Elem&& elem);
+
+		/**
+		 * brief: pop the top element if there is one
+		 * param: where to move the element
+		 * return: bool (false if the stack is empty)
+		 */
+		bool pop(Elem& elem);
+
+		/**
+		 * brief: check if it is empty (only a snapshot when other threads are working)
+		 * param: (void)
+		 * return: bool
+		 */
+		bool empty() const noexcept;
+
+	private:
+
+		struct _node
+		{
+			Elem value_;
+			std::atomic<uint32_t> next_;
+		};
+
+		/**
+		 * brief: the node of an index
+		 * param: the index
+		 * return: _node*
+		 */
+		_node* _at(uint32_t index) const noexcept;
+
+		/**
+		 * brief: a free node, reused or from the blocks
+		 * param: (void)
+		 * return: the index
+		 */
+		uint32_t _allocate();
+
+		/**
+		 * brief: push a node onto a tagged list
+		 * param: the list head and the index
+		 * return: void
+		 */
+		void _link(std::atomic<uint64_t>& head, uint32_t index) noexcept;
+
+		/**
+		 * brief: pop a node from a tagged list
+		 * param: the list head
+		 * return: the index, CONCURRENT_STACK_NIL if the list is empty
+		 */
+		uint32_t _unlink(std::atomic<uint64_t>& head) noexcept;
+
+		// the tag in the high 32 bits and the index of the top node in the low 32 bits
+		std::atomic<uint64_t> head_;
+
+		// the nodes popped and ready to be reused, in the same form
+		std::atomic<uint64_t> free_;
+
+		// the number of nodes ever taken from the blocks
+		std::atomic<uint32_t> used_;
+
+		// block k holds CONCURRENT_STACK_FIRST_BLOCK << k nodes
+		std::atomic<_node*> blocks_[32];
+	};
+
+	template<typename Elem>
+	inline concurrent_stack<Elem>::concurrent_stack()
+		: head_(CONCURRENT_STACK_NIL), free_(CONCURRENT_STACK_NIL), used_(0)
+	{
+		for (size_t k = 0; k != 32; k++) blocks_[k].store(nullptr, std::memory_order_relaxed);
+	}
+
+	template<typename Elem>
+	inline concurrent_stack<Elem>::~concurrent_stack()
+	{
+		for (size_t k = 0; k != 32; k++) delete[] blocks_[k].load(std::memory_order_relaxed);
+	}
+
+	template<typename Elem>
+	inline void concurrent_stack<Elem>::push(const Elem& elem)
+	{
+		const uint32_t index__ = _allocate();
+		_at(index__)->value_ = elem;
+		_link(head_, index__);
+	}
+
+	template<typename Elem>
+	inline void concurrent_stack<Elem>::push(Elem&& elem)
+	{
+		const uint32_t index__ = _allocate();
+		_at(index__)->value_ = std::move(elem);
+		_link(head_, index__);
+	}
+
+	template<typename Elem>
+	inline bool concurrent_stack<Elem>::pop(Elem& elem)
+	{
+		const uint32_t index__ = _unlink(head_);
+		if (index__ == CONCURRENT_STACK_NIL) return false;
+		elem = std::move(_at(index__)->value_); // the node is owned by this thread until it is freed
+		_link(free_, index__);
+		return true;
+	}
+
+	template<typename Elem>
+	inline bool concurrent_stack<Elem>::empty() const noexcept
+	{
+		return static_cast<uint32_t>(head_.load(std::memory_order_acquire)) == CONCURRENT_STACK_NIL;
+	}
+
+	template<typename Elem>
+	inline typename concurrent_stack<Elem>::_node* concurrent_stack<Elem>::_at(uint32_t index) const noexcept
+	{
+		const uint64_t shifted__ = static_cast<uint64_t>(index) + CONCURRENT_STACK_FIRST_BLOCK;
+		const unsigned high__ = shifted__ >> 32 ? 32 : _highest_bit_index(static_cast<uint32_t>(shifted__));
+		const unsigned block__ = high__ - _highest_bit_index(CONCURRENT_STACK_FIRST_BLOCK);
+		return blocks_[block__].load(std::memory_order_acquire) + (shifted__ - (static_cast<uint64_t>(1) << high__));
+	}
+
+	template<typename Elem>
+	inline uint32_t concurrent_stack<Elem>::_allocate()
+	{
+		const uint32_t reused__ = _unlink(free_);
+		if (reused__ != CONCURRENT_STACK_NIL) return reused__;
+		const uint32_t index__ = used_.fetch_add(1, std::memory_order_relaxed);
+		const unsigned block__ = _highest_bit_index(index__ + CONCURRENT_STACK_FIRST_BLOCK) - _highest_bit_index(CONCURRENT_STACK_FIRST_BLOCK);
+		if (!blocks_[block__].load(std::memory_order_acquire))
+		{
+			// the first thread to install the block wins, the others free theirs
+			_node* fresh__ = new _node[static_cast<size_t>(CONCURRENT_STACK_FIRST_BLOCK) << block__];
+			_node* expected__ = nullptr;
+			if (!blocks_[block__].compare_exchange_strong(expected__, fresh__, std::memory_order_acq_rel)) delete[] fresh__;
+		}
+		return index__;
+	}
+
+	template<typename Elem>
+	inline void concurrent_stack<Elem>::_link(std::atomic<uint64_t>& head, uint32_t index) noexcept
+	{
+		_node* node__ = _at(index);
+		uint64_t old__ = head.load(std::memory_order_relaxed);
+		uint64_t new__;
+		do
+		{
+			node__->next_.store(static_cast<uint32_t>(old__), std::memory_order_relaxed);
+			new__ = ((old__ >> 32) + 1) << 32 | index;
+		} while (!head.compare_exchange_weak(old__, new__, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	template<typename Elem>
+	inline uint32_t concurrent_stack<Elem>::_unlink(std::atomic<uint64_t>& head) noexcept
+	{
+		uint64_t old__ = head.load(std::memory_order_acquire);
+		for (;;)
+		{
+			const uint32_t index__ = static_cast<uint32_t>(old__);
+			if (index__ == CONCURRENT_STACK_NIL) return CONCURRENT_STACK_NIL;
+			// the node may be popped by another thread meanwhile, but it is never freed,
+			// and the tag makes the exchange below fail in that case
+			const uint32_t next__ = _at(index__)->next_.load(std::memory_order_relaxed);
+			const uint64_t new__ = ((old__ >> 32) + 1) << 32 | next__;
+			if (head.compare_exchange_weak(old__, new__, std::memory_order_acquire, std::memory_order_acquire)) return index__;
+		}
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
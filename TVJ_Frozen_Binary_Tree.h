@@ -0,0 +1,266 @@
+/*
+ * File: TVJ_Frozen_Binary_Tree.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_Compact_Binary_Tree.h 1.0, TVJ_Stack.h 1.2
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "TVJ_Compact_Binary_Tree.h"
+#include "TVJ_Stack.h"
+
+namespace tvj
+{
+	// a read-only copy of a binary tree (binary_tree, AVL_tree or compact_binary_tree) in one array,
+	// with the nodes in van Emde Boas order: the top half of the levels is laid out first and then each subtree below it,
+	// both recursively, so a path from the root to a leaf of height h touches O(log h / log B) blocks of B nodes
+	// for any cache line or page size,
+	// the shape and the inorder, preorder and postorder sequences are those of the original tree
+	template<typename Elem>
+	class frozen_binary_tree : protected compact_binary_tree<Elem>
+	{
+	public:
+		using const_iterator = typename compact_binary_tree<Elem>::const_iterator;
+		using inorder_const_iterator = const_iterator;
+		using preorder_const_iterator = const_iterator;
+		using postorder_const_iterator = const_iterator;
+
+		// constructor (an empty tree)
+		frozen_binary_tree() = default;
+
+		/**
+		 * brief: lay out a copy of a tree
+		 * param: the tree (which has preorder_cbegin, preorder_cend and has_left_child / has_right_child)
+		 * return: --
+		 */
+		template<typename Tree, typename = typename std::enable_if<!std::is_same<Tree, frozen_binary_tree>::value>::type>
+		explicit frozen_binary_tree(const Tree& tree);
+
+		using compact_binary_tree<Elem>::size;
+
+		/**
+		 * brief: search for the certain value, the tree is supposed to be sorted in inorder (e.g. from an AVL_tree)
+		 * param: the value
+		 * return: the iterator (i.e. inorder_const_iterator);
+		 *         if there is such a value, return the last one;
+		 *         if there is no such a value, return the last one that is smaller than it (before the beginning if none is).
+		 */
+		const_iterator search(const Elem& value) const noexcept;
+
+		/**
+		 * brief: check if there is the value in the tree (sorted in inorder)
+		 * param: the value
+		 * return: bool
+		 */
+		bool contains(const Elem& value) const noexcept;
+
+		/**
+		 * brief: the number of occurence of value in the tree (sorted in inorder)
+		 * param: the value
+		 * return: size_t
+		 */
+		size_t count(const Elem& value) const noexcept;
+
+		// @inorder_iterator
+		using compact_binary_tree<Elem>::inorder_croot;
+		using compact_binary_tree<Elem>::inorder_cbegin;
+		using compact_binary_tree<Elem>::inorder_cend;
+
+		// @preorder_iterator
+		using compact_binary_tree<Elem>::preorder_croot;
+		using compact_binary_tree<Elem>::preorder_cbegin;
+		using compact_binary_tree<Elem>::preorder_cend;
+
+		// @postorder_iterator
+		using compact_binary_tree<Elem>::postorder_croot;
+		using compact_binary_tree<Elem>::postorder_cbegin;
+		using compact_binary_tree<Elem>::postorder_cend;
+
+		// @iterator
+		using compact_binary_tree<Elem>::croot;
+		using compact_binary_tree<Elem>::cbegin;
+		using compact_binary_tree<Elem>::cend;
+		const_iterator root() const noexcept;
+		const_iterator begin() const noexcept;
+		const_iterator end() const noexcept;
+	};
+
+	/**
+	 * brief: lay out a read-only copy of a tree that is fully built
+	 * param: the tree
+	 * return: frozen_binary_tree
+	 */
+	template<template<typename> class Tree, typename Elem>
+	inline frozen_binary_tree<Elem> freeze(const Tree<Elem>& tree)
+	{
+		return frozen_binary_tree<Elem>(tree);
+	}
+
+	template<typename Elem>
+	template<typename Tree, typename>
+	inline frozen_binary_tree<Elem>::frozen_binary_tree(const Tree& tree)
+	{
+		const size_t size__ = tree.size();
+		if (size__ == 0) return;
+		if (size__ >= COMPACT_BT_NIL) throw std::overflow_error("Too many nodes to freeze in tvj::frozen_binary_tree.");
+		const uint32_t n__ = static_cast<uint32_t>(size__);
+
+		// number the nodes in preorder and record the children by these numbers
+		uint32_t* const links__ = new uint32_t[3 * static_cast<size_t>(n__)];
+		uint32_t* const left__ = links__;
+		uint32_t* const right__ = links__ + n__;
+		uint32_t* const place__ = links__ + 2 * static_cast<size_t>(n__); // the height first, and then the index in the array
+		try
+		{
+			segmented_stack<uint32_t> pending__; // the nodes whose right subtree comes later
+			uint32_t k = 0;
+			for (auto iter__ = tree.preorder_cbegin(); iter__ != tree.preorder_cend(); ++iter__, k++)
+			{
+				left__[k] = right__[k] = COMPACT_BT_NIL;
+				if (iter__.has_left_child())
+				{
+					left__[k] = k + 1;
+					if (iter__.has_right_child()) pending__.push(k);
+				}
+				else if (iter__.has_right_child())
+				{
+					right__[k] = k + 1;
+				}
+				else if (!pending__.empty())
+				{
+					right__[pending__.pop()] = k + 1;
+				}
+			}
+
+			// a child is numbered after its parent, so the heights are found backwards
+			for (uint32_t i = n__; i-- != 0; )
+			{
+				const uint32_t l__ = left__[i] != COMPACT_BT_NIL ? place__[left__[i]] : 0;
+				const uint32_t r__ = right__[i] != COMPACT_BT_NIL ? place__[right__[i]] : 0;
+				place__[i] = 1 + (l__ > r__ ? l__ : r__);
+			}
+			const uint32_t height__ = place__[0];
+
+			// a job (node, depth, height) lays out the subtrees of height levels rooted depth levels below the node,
+			// and with depth 0 it splits the levels into the top half and the subtrees below it
+			struct _job
+			{
+				uint32_t node_, depth_, height_;
+			};
+			segmented_stack<_job> jobs__;
+			jobs__.push(_job{ 0, 0, height__ });
+			uint32_t next__ = 1; // the node 0 of the array is the end
+			while (!jobs__.empty())
+			{
+				const _job job__ = jobs__.pop();
+				if (job__.depth_)
+				{
+					if (right__[job__.node_] != COMPACT_BT_NIL) jobs__.push(_job{ right__[job__.node_], job__.depth_ - 1, job__.height_ });
+					if (left__[job__.node_] != COMPACT_BT_NIL) jobs__.push(_job{ left__[job__.node_], job__.depth_ - 1, job__.height_ });
+				}
+				else if (job__.height_ == 1 || (left__[job__.node_] == COMPACT_BT_NIL && right__[job__.node_] == COMPACT_BT_NIL))
+				{
+					place__[job__.node_] = next__++;
+				}
+				else
+				{
+					const uint32_t top__ = job__.height_ / 2;
+					jobs__.push(_job{ job__.node_, top__, job__.height_ - top__ });
+					jobs__.push(_job{ job__.node_, 0, top__ });
+				}
+			}
+
+			this->reserve(size__);
+			this->used_ = n__ + 1;
+			this->size_ = size__;
+			this->_link(0).L_child_ = place__[0];
+			this->_link(place__[0]).parent_ = 0;
+			k = 0;
+			for (auto iter__ = tree.preorder_cbegin(); iter__ != tree.preorder_cend(); ++iter__, k++)
+			{
+				const uint32_t node__ = place__[k];
+				typename compact_binary_tree<Elem>::_links& node_links__ = this->_link(node__);
+				node_links__.L_child_ = left__[k] != COMPACT_BT_NIL ? place__[left__[k]] : COMPACT_BT_NIL;
+				node_links__.R_child_ = right__[k] != COMPACT_BT_NIL ? place__[right__[k]] : COMPACT_BT_NIL;
+				if (node_links__.L_child_ != COMPACT_BT_NIL) this->_link(node_links__.L_child_).parent_ = node__;
+				if (node_links__.R_child_ != COMPACT_BT_NIL) this->_link(node_links__.R_child_).parent_ = node__;
+				this->_data(node__) = *iter__;
+			}
+		}
+		catch (...)
+		{
+			delete[] links__;
+			throw;
+		}
+		delete[] links__;
+	}
+
+	template<typename Elem>
+	inline typename frozen_binary_tree<Elem>::const_iterator frozen_binary_tree<Elem>::search(const Elem& value) const noexcept
+	{
+		// the last node not greater than the value on the path down
+		uint32_t found__ = COMPACT_BT_NIL;
+		uint32_t p__ = this->_link(0).L_child_;
+		while (p__ != COMPACT_BT_NIL)
+		{
+			const typename compact_binary_tree<Elem>::_links& links__ = this->_link(p__);
+			if (value < this->_data(p__))
+			{
+				p__ = links__.L_child_;
+			}
+			else
+			{
+				found__ = p__;
+				p__ = links__.R_child_;
+			}
+		}
+		return this->_const_iterator(compact_binary_tree<Elem>::INORDER, found__);
+	}
+
+	template<typename Elem>
+	inline bool frozen_binary_tree<Elem>::contains(const Elem& value) const noexcept
+	{
+		const const_iterator iter__ = search(value);
+		return !iter__.is_before_begin() && !(*iter__ < value);
+	}
+
+	template<typename Elem>
+	inline size_t frozen_binary_tree<Elem>::count(const Elem& value) const noexcept
+	{
+		size_t cnt__ = 0;
+		for (const_iterator iter__ = search(value); !iter__.is_before_begin() && !(*iter__ < value); --iter__) cnt__++;
+		return cnt__;
+	}
+
+	template<typename Elem>
+	inline typename frozen_binary_tree<Elem>::const_iterator frozen_binary_tree<Elem>::root() const noexcept
+	{
+		return this->croot();
+	}
+
+	template<typename Elem>
+	inline typename frozen_binary_tree<Elem>::const_iterator frozen_binary_tree<Elem>::begin() const noexcept
+	{
+		return this->cbegin();
+	}
+
+	template<typename Elem>
+	inline typename frozen_binary_tree<Elem>::const_iterator frozen_binary_tree<Elem>::end() const noexcept
+	{
+		return this->cend();
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
@@ -0,0 +1,203 @@
+/*
+ * File: TVJ_Hash.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_String.h 1.6, TVJ_String_View.h 1.0
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+#include "TVJ_String.h"
+#include "TVJ_String_View.h"
+
+// The hash follows wyhash (final version 4, public domain, by Wang Yi):
+// short keys are read with at most two overlapping loads,
+// long keys are mixed 48 bytes at a time through three independent 64x64->128 multiplications.
+
+namespace tvj
+{
+	/**
+	 * brief: the full 128-bit product of two 64-bit numbers
+	 * param: the two numbers (replaced by the low and the high 64 bits)
+	 * return: void
+	 */
+	inline void _hash_multiply(uint64_t& a, uint64_t& b) noexcept
+	{
+#if defined(__SIZEOF_INT128__)
+		__uint128_t product__ = a;
+		product__ *= b;
+		a = static_cast<uint64_t>(product__);
+		b = static_cast<uint64_t>(product__ >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		a = _umul128(a, b, &b);
+#else
+		const uint64_t ha__ = a >> 32, hb__ = b >> 32, la__ = static_cast<uint32_t>(a), lb__ = static_cast<uint32_t>(b);
+		const uint64_t rh__ = ha__ * hb__, rm0__ = ha__ * lb__, rm1__ = hb__ * la__, rl__ = la__ * lb__;
+		const uint64_t t__ = rl__ + (rm0__ << 32);
+		uint64_t carry__ = t__ < rl__;
+		const uint64_t low__ = t__ + (rm1__ << 32);
+		carry__ += low__ < t__;
+		a = low__;
+		b = rh__ + (rm0__ >> 32) + (rm1__ >> 32) + carry__;
+#endif
+	}
+
+	/**
+	 * brief: multiply and fold the 128-bit product
+	 * param: the two numbers
+	 * return: uint64_t
+	 */
+	inline uint64_t _hash_mix(uint64_t a, uint64_t b) noexcept
+	{
+		_hash_multiply(a, b);
+		return a ^ b;
+	}
+
+	/**
+	 * brief: read 8 bytes (unaligned)
+	 * param: the pointer
+	 * return: uint64_t
+	 */
+	inline uint64_t _hash_read8(const unsigned char* p) noexcept
+	{
+		uint64_t value__;
+		memcpy(&value__, p, 8);
+		return value__;
+	}
+
+	/**
+	 * brief: read 4 bytes (unaligned)
+	 * param: the pointer
+	 * return: uint64_t
+	 */
+	inline uint64_t _hash_read4(const unsigned char* p) noexcept
+	{
+		uint32_t value__;
+		memcpy(&value__, p, 4);
+		return value__;
+	}
+
+	/**
+	 * brief: hash a byte array
+	 * param: the bytes, the number of bytes and the seed (default as 0)
+	 * return: uint64_t
+	 */
+	inline uint64_t hash_bytes(const void* data, size_t length, uint64_t seed = 0) noexcept
+	{
+		static const uint64_t secret__[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+		const unsigned char* p = static_cast<const unsigned char*>(data);
+		seed ^= _hash_mix(seed ^ secret__[0], secret__[1]);
+		uint64_t a, b;
+		if (length <= 16)
+		{
+			if (length >= 4)
+			{
+				a = (_hash_read4(p) << 32) | _hash_read4(p + ((length >> 3) << 2));
+				b = (_hash_read4(p + length - 4) << 32) | _hash_read4(p + length - 4 - ((length >> 3) << 2));
+			}
+			else if (length > 0)
+			{
+				a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[length >> 1]) << 8) | p[length - 1];
+				b = 0;
+			}
+			else
+			{
+				a = b = 0;
+			}
+		}
+		else
+		{
+			size_t i = length;
+			if (i >= 48)
+			{
+				uint64_t seed1__ = seed, seed2__ = seed;
+				do
+				{
+					seed = _hash_mix(_hash_read8(p) ^ secret__[1], _hash_read8(p + 8) ^ seed);
+					seed1__ = _hash_mix(_hash_read8(p + 16) ^ secret__[2], _hash_read8(p + 24) ^ seed1__);
+					seed2__ = _hash_mix(_hash_read8(p + 32) ^ secret__[3], _hash_read8(p + 40) ^ seed2__);
+					p += 48;
+					i -= 48;
+				} while (i >= 48);
+				seed ^= seed1__ ^ seed2__;
+			}
+			while (i > 16)
+			{
+				seed = _hash_mix(_hash_read8(p) ^ secret__[1], _hash_read8(p + 8) ^ seed);
+				i -= 16;
+				p += 16;
+			}
+			a = _hash_read8(p + i - 16);
+			b = _hash_read8(p + i - 8);
+		}
+		a ^= secret__[1];
+		b ^= seed;
+		_hash_multiply(a, b);
+		return _hash_mix(a ^ secret__[0] ^ length, b ^ secret__[1]);
+	}
+
+	/**
+	 * brief: hash a string view
+	 * param: the string view and the seed (default as 0)
+	 * return: uint64_t
+	 */
+	inline uint64_t hash(const string_view& str, uint64_t seed = 0) noexcept
+	{
+		return hash_bytes(str.data(), str.size(), seed);
+	}
+
+	/**
+	 * brief: hash a string
+	 * param: the string and the seed (default as 0)
+	 * return: uint64_t
+	 */
+	inline uint64_t hash(const string& str, uint64_t seed = 0) noexcept
+	{
+		return hash_bytes(str.data(), str.size(), seed);
+	}
+
+	// the hash function object for string and string_view
+	struct string_hash
+	{
+		size_t operator()(const string_view& str) const noexcept
+		{
+			return static_cast<size_t>(hash(str));
+		}
+	};
+}
+
+namespace std
+{
+	template<>
+	struct hash<tvj::string>
+	{
+		size_t operator()(const tvj::string& str) const noexcept
+		{
+			return static_cast<size_t>(tvj::hash(str));
+		}
+	};
+
+	template<>
+	struct hash<tvj::string_view>
+	{
+		size_t operator()(const tvj::string_view& str) const noexcept
+		{
+			return static_cast<size_t>(tvj::hash(str));
+		}
+	};
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
@@ -5,7 +5,16 @@
  * @author: Teddy van Jerry
  * @licence: The MIT Licence
  * @compiler: at least C++/11 (tested on MSVC)
- * @reliance: TVJ_Huffman_Tree.h 1.4
+ * @reliance: TVJ_Huffman_Tree.h 1.6, TVJ_Bit_String.h 1.0
+ *
+ * @version 1.4 2026/10/18
+ * - decode returns false for a bit that leads to no node, a code cut off at the end or a char other than '0' and '1'
+ * - decode from a string or a file reads the bits first and decodes them as a bit_string
+ *
+ * @version 1.3 2026/10/18
+ * - codes are bit_string
+ * - add encode to a bit_string and decode from a bit_string
+ * - bug fix: EOF is no longer encoded when reading from a file
  *
  * @version 1.2 2021/05/14
  * - initial version for huffman coding
@@ -43,12 +52,16 @@ namespace tvj
 
 		void print_code_table() const noexcept;
 
-		string code_of(const char& ch) const noexcept;
+		bit_string code_of(const char& ch) const noexcept;
+
+		bool encode(const string& str, HF_Coding_Source source, bit_string& result) const;
 
 		bool encode(const string& str, HF_Coding_Source source, string& result) const;
 
 		bool encode_to_file(const string& str, HF_Coding_Source source, const string& file_name) const;
 
+		bool decode(const bit_string& bits, string& result) const;
+
 		bool decode(const string& str, HF_Coding_Source source, string& result) const;
 
 		bool decode_to_file(const string& str, HF_Coding_Source source, const string& file_name) const;
@@ -141,7 +154,6 @@ namespace tvj
 			}
 		}
 		tree_.set_weight_info(vec);
-		vec.no_delete(); // this function should be used carefully
 	}
 
 	inline vector<HF_code<char>> huffman_coding::code_table() const noexcept
@@ -164,12 +176,12 @@ namespace tvj
 		}
 	}
 
-	inline string huffman_coding::code_of(const char& ch) const noexcept
+	inline bit_string huffman_coding::code_of(const char& ch) const noexcept
 	{
 		return tree_.huffman_code(ch);
 	}
 
-	inline bool huffman_coding::encode(const string& str, HF_Coding_Source source, string& result) const
+	inline bool huffman_coding::encode(const string& str, HF_Coding_Source source, bit_string& result) const
 	{
 		bool ok = true;
 		result.clear();
@@ -179,27 +191,41 @@ namespace tvj
 			fopen_s(&input_file, str.c_str(), "r");
 			if (input_file)
 			{
-				size_t count__ = 0;
-				while (!feof(input_file))
+				int ch;
+				while ((ch = getc(input_file)) != EOF)
 				{
-					char ch = getc(input_file);
-					string code = this->code_of(ch);
+					const bit_string code = this->code_of(static_cast<char>(ch));
+					if (code.empty()) ok = false; // not in the code table
 					result.append(code);
-					if (code[0] == '?') ok = false;
 				}
 				fclose(input_file);
 			}
+			else
+			{
+				ok = false;
+			}
 		}
 		else
 		{
 			for (const auto& ch : str)
 			{
-				result.append(this->code_of(ch));
+				const bit_string code = this->code_of(ch);
+				if (code.empty()) ok = false; // not in the code table
+				result.append(code);
 			}
 		}
 		return ok;
 	}
 
+	inline bool huffman_coding::encode(const string& str, HF_Coding_Source source, string& result) const
+	{
+		bit_string bits__;
+		const bool ok = encode(str, source, bits__);
+		result.clear();
+		bits__.append_to(result);
+		return ok;
+	}
+
 	inline bool huffman_coding::encode_to_file(const string& str, HF_Coding_Source source, const string& file_name) const
 	{
 		string result;
@@ -217,64 +243,54 @@ namespace tvj
 		return ok;
 	}
 
+	inline bool huffman_coding::decode(const bit_string& bits, string& result) const
+	{
+		result.clear();
+		if (!tree_.size()) return bits.empty();
+		auto iter = tree_.root();
+		for (size_t i = 0; i != bits.size(); i++)
+		{
+			if (bits[i] ? !iter.has_right_child() : !iter.has_left_child()) return false; // not a code
+			iter = bits[i] ? iter.right_child() : iter.left_child();
+			if (iter.is_leaf()) // the code terminates
+			{
+				result.append(*iter);
+				iter = tree_.root();
+			}
+		}
+		return iter == tree_.root(); // no code is cut off at the end
+	}
+
 	inline bool huffman_coding::decode(const string& str, HF_Coding_Source source, string& result) const
 	{
-		bool ok = true;
+		bit_string bits__;
 		result.clear();
 		if (source == HF_FILE)
 		{
 			std::FILE* input_file;
 			fopen_s(&input_file, str.c_str(), "r");
-			auto iter = tree_.root();
-			if (input_file)
+			if (!input_file) return false;
+			int ch;
+			while ((ch = getc(input_file)) != EOF)
 			{
-				while (!feof(input_file))
+				if (ch != '0' && ch != '1')
 				{
-					char ch = getc(input_file);
-					if (ch == '0')
-					{
-						iter = iter.left_child();
-					}
-					else
-					{
-						iter = iter.right_child();
-					}
-
-					if (iter.is_leaf()) // the code terminates
-					{
-						result.append(*iter);
-						iter = tree_.root();
-					}
+					fclose(input_file);
+					return false;
 				}
-				fclose(input_file);
-			}
-			else
-			{
-				return false;
+				bits__.push_back(ch == '1');
 			}
+			fclose(input_file);
 		}
 		else
 		{
-			auto iter = tree_.root();
 			for (const auto& ch : str)
 			{
-				if (ch == '0')
-				{
-					iter = iter.left_child();
-				}
-				else
-				{
-					iter = iter.right_child();
-				}
-
-				if (iter.is_leaf()) // the code terminates
-				{
-					result.append(*iter);
-					iter = tree_.root();
-				}
+				if (ch != '0' && ch != '1') return false;
+				bits__.push_back(ch == '1');
 			}
 		}
-		return ok;
+		return decode(bits__, result);
 	}
 
 	inline bool huffman_coding::decode_to_file(const string& str, HF_Coding_Source source, const string& file_name) const
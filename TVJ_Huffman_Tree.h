@@ -5,7 +5,23 @@
  * @author: Teddy van Jerry
  * @licence: The MIT Licence
  * @compiler: at least C++/11 (tested on MSVC)
- * @reliance: TVJ_Vector.h 1.4
+ * @reliance: TVJ_Vector.h 1.4, TVJ_Bit_String.h 1.0
+ *
+ * @version 1.6 2026/10/18
+ * - add the missing typename of HF_Node::node_
+ *
+ * @version 1.5 2026/10/18
+ * - the nodes are allocated from the pool of the tree, and set_weight_info frees the old tree first
+ * - the forest holds its HF_Node entries by value (no more leaks)
+ *
+ * @version 1.4 2026/10/18
+ * - the sequences of the tree are marked out of date after it is created instead of rebuilt
+ * - the nodes are linked to their parents (and the size is right for a single element)
+ *
+ * @version 1.3 2026/10/18
+ * - codes are stored as bit_string instead of a string of '0' and '1'
+ * - the codes are created by backtracking on one bit_string instead of copying
+ * - function huffman_code returns an empty code for unknown elements
  *
  * @version 1.2 2021/05/14
  * - initial version for huffman tree
@@ -16,6 +32,7 @@
 
 #include "TVJ_Binary_Tree.h"
 #include "TVJ_String.h"
+#include "TVJ_Bit_String.h"
 
 namespace tvj
 {
@@ -36,7 +53,7 @@ namespace tvj
 	struct HF_code
 	{
 		Elem elem_;
-		string code_ = "";
+		bit_string code_;
 	};
 
 	template<typename Elem>
@@ -50,7 +67,7 @@ namespace tvj
 		// the node in huffman tree that includes weight
 		struct HF_Node
 		{
-			binary_tree<Elem>::BT_Node* node_;
+			typename binary_tree<Elem>::BT_Node* node_;
 			unsigned weight_ = 0;
 
 			HF_Node();
@@ -72,14 +89,14 @@ namespace tvj
 
 		vector<HF_code> all_code() const noexcept;
 
-		string huffman_code(const Elem& elem) const noexcept;
+		bit_string huffman_code(const Elem& elem) const noexcept;
 
 	private:
 		void _create_tree() noexcept;
 
 		void _create_code() noexcept;
 
-		void _create_code_one(typename binary_tree<Elem>::const_iterator node, string curr_code) noexcept;
+		void _create_code_one(typename binary_tree<Elem>::const_iterator node, bit_string& curr_code) noexcept;
 	};
 
 	template<typename Elem>
@@ -95,7 +112,7 @@ namespace tvj
 		//	std::cout << c.elem_ << ' ' << c.weight_ << std::endl;
 		//}
 		_create_tree();
-		this->_inorder_update();
+		this->_invalidate_sequences();
 		_create_code();
 	}
 
@@ -104,8 +121,10 @@ namespace tvj
 	{
 		weight_sequence_ = vec_weighted_info;
 		weight_sequence_.sort(DESCENDING);
+		this->_clear();
+		all_code_.clear();
 		_create_tree();
-		this->_inorder_update();
+		this->_invalidate_sequences();
 		_create_code();
 	}
 
@@ -116,13 +135,13 @@ namespace tvj
 	}
 
 	template<typename Elem>
-	inline string huffman_tree<Elem>::huffman_code(const Elem& elem) const noexcept
+	inline bit_string huffman_tree<Elem>::huffman_code(const Elem& elem) const noexcept
 	{
 		for (const auto& c__ : this->all_code_)
 		{
 			if (c__.elem_ == elem) return c__.code_;
 		}
-		return "?";
+		return bit_string(); // not in the tree
 	}
 
 	template<typename Elem>
@@ -131,17 +150,16 @@ namespace tvj
 		if (this->weight_sequence_.size() == 0) return;
 		if (this->weight_sequence_.size() == 1)
 		{
-			this->root_parent_.L_child_ = new typename binary_tree<Elem>::BT_Node;
-			this->root_parent_.L_child_->L_child_ = new typename binary_tree<Elem>::BT_Node(this->root_parent_.L_child_, this->weight_sequence_[0].elem_);
+			typename binary_tree<Elem>::BT_Node* leaf__ = this->_new_node(nullptr, this->weight_sequence_[0].elem_);
+			this->root_parent_.L_child_ = this->_new_node(&this->root_parent_, Elem(), leaf__);
+			this->size_ = 2;
 			return;
 		}
 
 		vector<HF_Node> forest__;
 		for (const weighted_info& c__ : this->weight_sequence_)
 		{
-			typename binary_tree<Elem>::BT_Node* BT_node__= new typename binary_tree<Elem>::BT_Node(nullptr, c__.elem_);
-			HF_Node* node__ = new HF_Node(BT_node__, c__.weight_);
-			forest__.push_back(*node__);
+			forest__.push_back(HF_Node(this->_new_node(nullptr, c__.elem_), c__.weight_));
 		}
 		this->size_ = forest__.size();
 
@@ -149,27 +167,28 @@ namespace tvj
 		{
 			this->size_++;
 			typename binary_tree<Elem>::BT_Node* BT_node__ =
-				new typename binary_tree<Elem>::BT_Node(nullptr, forest__[0].node_->data_,
+				this->_new_node(nullptr, forest__[0].node_->data_,
 					forest__[forest__.size() - 2].node_, forest__[forest__.size() - 1].node_);
-			HF_Node* node__ = new HF_Node(BT_node__, forest__[forest__.size() - 2].weight_ + forest__[forest__.size() - 1].weight_);
+			const HF_Node node__(BT_node__, forest__[forest__.size() - 2].weight_ + forest__[forest__.size() - 1].weight_);
 			forest__.pop_back();
 			forest__.pop_back();
-			forest__.push_back(*node__);
+			forest__.push_back(node__);
 			forest__.insertion_sort(DESCENDING);
 			//for (size_t i = 0; i != forest__.size(); i++)
 			//{
-			//	if (forest__[i].weight_ > node__->weight_) continue;
-			//	forest__.push_back(*node__);
+			//	if (forest__[i].weight_ > node__.weight_) continue;
+			//	forest__.push_back(node__);
 			//	for (size_t j = forest__.size() - 2;; j--)
 			//	{
 			//		forest__[j + 1] = forest__[j];
 			//		if (j == i) break;
 			//	}
-			//	forest__[i] = *node__;
+			//	forest__[i] = node__;
 			//	break;
 			//}
 		}
 		this->root_parent_.L_child_ = forest__[0].node_;
+		this->root_parent_.L_child_->parent_ = &this->root_parent_;
 	}
 
 	template<typename Elem>
@@ -182,21 +201,35 @@ namespace tvj
 		//}
 		//std::cout << std::endl;
 
-		_create_code_one(this->root(), "");
+		bit_string code__;
+		_create_code_one(this->root(), code__);
 	}
 
 	template<typename Elem>
-	inline void huffman_tree<Elem>::_create_code_one(typename binary_tree<Elem>::const_iterator node, string curr_code) noexcept
+	inline void huffman_tree<Elem>::_create_code_one(typename binary_tree<Elem>::const_iterator node, bit_string& curr_code) noexcept
 	{
 		if (node.is_leaf())
 		{
-			HF_code hf_code__ = { *node, curr_code };
+			HF_code hf_code__;
+			hf_code__.elem_ = *node;
+			hf_code__.code_ = curr_code;
 			all_code_.push_back(hf_code__);
 		}
 		else
 		{
-			if (node.has_left_child())  _create_code_one(node.left_child(),  curr_code + '0');
-			if (node.has_right_child()) _create_code_one(node.right_child(), curr_code + '1');
+			// one bit is pushed before going down and popped after coming back
+			if (node.has_left_child())
+			{
+				curr_code.push_back(false);
+				_create_code_one(node.left_child(), curr_code);
+				curr_code.pop_back();
+			}
+			if (node.has_right_child())
+			{
+				curr_code.push_back(true);
+				_create_code_one(node.right_child(), curr_code);
+				curr_code.pop_back();
+			}
 		}
 	}
 
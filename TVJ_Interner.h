@@ -0,0 +1,266 @@
+/*
+ * File: TVJ_Interner.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_Vector.h 1.6, TVJ_String_View.h 1.0, TVJ_Hash.h 1.0
+ *
+ * @version 1.1 2026/10/18
+ * - function intern throws std::length_error instead of wrapping the ids around
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "TVJ_String_View.h"
+#include "TVJ_Hash.h"
+
+namespace tvj
+{
+#define INTERNER_INVALID_ID 0xFFFFFFFFu // returned by function find if the string is not interned
+#define INTERNER_BLOCK_SIZE 65536       // the size of one arena block
+
+	// map strings to stable 32-bit ids (0, 1, 2, ... in the order they first appear),
+	// equal strings get the same id so that they can be compared as integers
+	class interner
+	{
+	public:
+
+		/**
+		 * brief: default constructor
+		 * param: (void)
+		 * return: --
+		 */
+		interner();
+
+		interner(const interner&) = delete;
+		interner& operator=(const interner&) = delete;
+
+		/**
+		 * brief: destructor
+		 * param: (void)
+		 * return: --
+		 */
+		~interner();
+
+		/**
+		 * brief: the id of a string, the string is copied into the arena if it is new
+		 *        (std::length_error is thrown if INTERNER_INVALID_ID strings are interned already)
+		 * param: the string
+		 * return: uint32_t
+		 */
+		uint32_t intern(const string_view& str);
+
+		/**
+		 * brief: the id of a string without adding it
+		 * param: the string
+		 * return: uint32_t (INTERNER_INVALID_ID if it is not interned)
+		 */
+		uint32_t find(const string_view& str) const noexcept;
+
+		/**
+		 * brief: check if a string is interned
+		 * param: the string
+		 * return: bool
+		 */
+		bool contains(const string_view& str) const noexcept;
+
+		/**
+		 * brief: the string of an id, valid as long as the interner
+		 * param: the id
+		 * return: string_view
+		 */
+		string_view view(uint32_t id) const;
+
+		/**
+		 * brief: the number of interned strings
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: make room for a certain number of strings without rehashing
+		 * param: the number of strings
+		 * return: void
+		 */
+		void reserve(size_t count);
+
+		/**
+		 * brief: remove all strings (all ids and views are invalidated)
+		 * param: (void)
+		 * return: void
+		 */
+		void clear();
+
+	private:
+
+		/**
+		 * brief: copy chars into the arena
+		 * param: the chars and the number of chars
+		 * return: where they are stored
+		 */
+		const char* _store(const char* str, size_t length);
+
+		/**
+		 * brief: the slot of a string, an empty slot if it is not interned
+		 * param: the string and its hash
+		 * return: size_t
+		 */
+		size_t _probe(const string_view& str, uint64_t hash) const noexcept;
+
+		/**
+		 * brief: rebuild the slots and put the ids again
+		 * param: the number of slots (a power of 2)
+		 * return: void
+		 */
+		void _rehash(size_t slots);
+
+		// the interned strings in the order of ids
+		vector<string_view> views_;
+
+		// the hashes in the order of ids (so that rehashing need not read the strings)
+		vector<uint64_t> hashes_;
+
+		// open addressing with linear probing: id + 1, 0 for an empty slot
+		vector<uint32_t> slots_;
+
+		// slots_.size() - 1 (the number of slots is a power of 2)
+		size_t mask_ = 0;
+
+		// arena blocks, the chars never move so that the views stay valid
+		vector<char*> blocks_;
+		char* cursor_ = nullptr;
+		size_t left_ = 0;
+	};
+
+	inline interner::interner()
+	{
+		_rehash(64);
+	}
+
+	inline interner::~interner()
+	{
+		for (size_t i = 0; i != blocks_.size(); i++)
+		{
+			delete[] blocks_[i];
+		}
+	}
+
+	inline uint32_t interner::intern(const string_view& str)
+	{
+		const uint64_t hash__ = hash(str);
+		size_t slot__ = _probe(str, hash__);
+		if (slots_[slot__]) return slots_[slot__] - 1;
+		// a slot keeps id + 1 in 32 bits, and INTERNER_INVALID_ID itself is no id
+		if (views_.size() >= INTERNER_INVALID_ID) throw std::length_error("too many strings in tvj::interner");
+		if ((views_.size() + 1) * 2 > slots_.size()) // keep the load factor under 1/2
+		{
+			_rehash(slots_.size() << 1);
+			slot__ = _probe(str, hash__);
+		}
+		const uint32_t id__ = static_cast<uint32_t>(views_.size());
+		views_.push_back(string_view(_store(str.data(), str.size()), str.size()));
+		hashes_.push_back(hash__);
+		slots_[slot__] = id__ + 1;
+		return id__;
+	}
+
+	inline uint32_t interner::find(const string_view& str) const noexcept
+	{
+		const uint32_t entry__ = slots_[_probe(str, hash(str))];
+		return entry__ ? entry__ - 1 : INTERNER_INVALID_ID;
+	}
+
+	inline bool interner::contains(const string_view& str) const noexcept
+	{
+		return find(str) != INTERNER_INVALID_ID;
+	}
+
+	inline string_view interner::view(uint32_t id) const
+	{
+		return views_[id];
+	}
+
+	inline size_t interner::size() const noexcept
+	{
+		return views_.size();
+	}
+
+	inline void interner::reserve(size_t count)
+	{
+		size_t slots__ = slots_.size();
+		while (slots__ < count * 2) slots__ <<= 1;
+		if (slots__ != slots_.size()) _rehash(slots__);
+	}
+
+	inline void interner::clear()
+	{
+		for (size_t i = 0; i != blocks_.size(); i++)
+		{
+			delete[] blocks_[i];
+		}
+		blocks_.clear();
+		cursor_ = nullptr;
+		left_ = 0;
+		views_.clear();
+		hashes_.clear();
+		_rehash(64);
+	}
+
+	inline const char* interner::_store(const char* str, size_t length)
+	{
+		if (length > left_)
+		{
+			if (length > INTERNER_BLOCK_SIZE / 4) // a long string gets a block of its own
+			{
+				char* block__ = new char[length ? length : 1];
+				memcpy(block__, str, length);
+				blocks_.push_back(block__);
+				return block__;
+			}
+			cursor_ = new char[INTERNER_BLOCK_SIZE];
+			left_ = INTERNER_BLOCK_SIZE;
+			blocks_.push_back(cursor_);
+		}
+		char* stored__ = cursor_;
+		memcpy(stored__, str, length);
+		cursor_ += length;
+		left_ -= length;
+		return stored__;
+	}
+
+	inline size_t interner::_probe(const string_view& str, uint64_t hash) const noexcept
+	{
+		size_t slot__ = static_cast<size_t>(hash) & mask_;
+		for (;;)
+		{
+			const uint32_t entry__ = slots_[slot__];
+			if (!entry__) return slot__;
+			if (hashes_[entry__ - 1] == hash && views_[entry__ - 1] == str) return slot__;
+			slot__ = (slot__ + 1) & mask_;
+		}
+	}
+
+	inline void interner::_rehash(size_t slots)
+	{
+		slots_ = vector<uint32_t>(slots, 0, slots + 1);
+		mask_ = slots - 1;
+		for (size_t id = 0; id != views_.size(); id++)
+		{
+			size_t slot__ = static_cast<size_t>(hashes_[id]) & mask_;
+			while (slots_[slot__]) slot__ = (slot__ + 1) & mask_;
+			slots_[slot__] = static_cast<uint32_t>(id + 1);
+		}
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
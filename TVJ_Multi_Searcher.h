@@ -0,0 +1,380 @@
+/*
+ * File: TVJ_Multi_Searcher.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_Vector.h 1.6, TVJ_String.h 1.4
+ *
+ * @version 1.2 2026/10/18
+ * - function build throws std::length_error when the table entries no longer fit in 32 bits
+ * 
+ * @version 1.1 2026/10/18
+ * - use function data of tvj::string
+ * 
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "TVJ_String.h"
+
+namespace tvj
+{
+#define MULTI_SEARCHER_MAX_ENTRIES 0x7fffffffU // the largest premultiplied state, so that an entry (twice it, plus 1) fits in uint32_t
+
+	// one occurrence reported by multi_searcher
+	struct multi_match
+	{
+		size_t pattern_id_ = 0; // the index of the pattern (in the order they are added)
+		size_t offset_ = 0;     // the index in the text where the occurrence begins
+	};
+
+	// an Aho-Corasick automaton that finds all occurrences of many patterns in one pass
+	class multi_searcher
+	{
+	public:
+
+		/**
+		 * brief: default constructor, patterns are added by function add
+		 * param: (void)
+		 * return: --
+		 */
+		multi_searcher();
+
+		/**
+		 * brief: constructor, the automaton is built at once
+		 * param: the patterns (the index is the pattern id)
+		 * return: --
+		 */
+		multi_searcher(const vector<string>& patterns);
+
+		/**
+		 * brief: add a pattern (empty patterns never match),
+		 *        function build should be called before searching
+		 * param: the pattern
+		 * return: the pattern id
+		 */
+		size_t add(const string& pattern);
+
+		/**
+		 * brief: add a pattern (empty patterns never match),
+		 *        function build should be called before searching
+		 * param: the pattern and its length
+		 * return: the pattern id
+		 */
+		size_t add(const char* pattern, size_t length);
+
+		/**
+		 * brief: compile all the added patterns into the automaton,
+		 *        std::length_error is thrown if the states times the byte classes exceed MULTI_SEARCHER_MAX_ENTRIES
+		 * param: (void)
+		 * return: void
+		 */
+		void build();
+
+		/**
+		 * brief: the number of patterns
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: the length of a pattern
+		 * param: the pattern id
+		 * return: size_t
+		 */
+		size_t pattern_length(size_t pattern_id) const;
+
+		/**
+		 * brief: call func(pattern_id, offset) for every occurrence,
+		 *        in the order of the end of the occurrences
+		 * param: the text, its length and the function
+		 * return: void
+		 */
+		template<typename Func>
+		void for_each_match(const char* text, size_t length, Func func) const;
+
+		/**
+		 * brief: all occurrences, in the order of the end of the occurrences
+		 * param: the text
+		 * return: vector<multi_match>
+		 */
+		vector<multi_match> find_all(const string& text) const;
+
+		/**
+		 * brief: all occurrences, in the order of the end of the occurrences
+		 * param: the text and its length
+		 * return: vector<multi_match>
+		 */
+		vector<multi_match> find_all(const char* text, size_t length) const;
+
+		/**
+		 * brief: count all occurrences of all patterns
+		 * param: the text
+		 * return: size_t
+		 */
+		size_t count(const string& text) const;
+
+		/**
+		 * brief: count all occurrences of all patterns
+		 * param: the text and its length
+		 * return: size_t
+		 */
+		size_t count(const char* text, size_t length) const;
+
+	private:
+
+		/**
+		 * brief: report the patterns ending at the current state and those along the dictionary links
+		 * param: the state, the index one past the end of the occurrence and the function
+		 * return: void
+		 */
+		template<typename Func>
+		void _report(uint32_t state, size_t end, Func& func) const;
+
+		// all patterns one after another
+		vector<char> pattern_text_;
+
+		// where each pattern ends in pattern_text_
+		vector<size_t> pattern_end_;
+
+		// byte -> byte class, bytes that appear in no pattern share one class
+		unsigned char classes_[256];
+
+		// the number of byte classes (the width of a row in the transition table)
+		uint32_t stride_ = 1;
+
+		// the full transition table, row after row;
+		// an entry is (target state * stride_) * 2, plus 1 if the target reports anything
+		vector<uint32_t> table_;
+
+		// patterns ending at a state: out_ids_[out_begin_[s], out_begin_[s + 1])
+		vector<uint32_t> out_begin_;
+		vector<uint32_t> out_ids_;
+
+		// the nearest state along the failure links that has its own patterns, 0 if none
+		vector<uint32_t> dict_link_;
+
+		// whether the automaton reflects all added patterns
+		bool built_ = false;
+	};
+
+	inline multi_searcher::multi_searcher()
+	{
+		build();
+	}
+
+	inline multi_searcher::multi_searcher(const vector<string>& patterns)
+	{
+		for (size_t i = 0; i != patterns.size(); i++)
+		{
+			add(patterns[i]);
+		}
+		build();
+	}
+
+	inline size_t multi_searcher::add(const string& pattern)
+	{
+		return add(pattern.data(), pattern.size());
+	}
+
+	inline size_t multi_searcher::add(const char* pattern, size_t length)
+	{
+		for (size_t i = 0; i != length; i++)
+		{
+			pattern_text_.push_back(pattern[i]);
+		}
+		pattern_end_.push_back(pattern_text_.size());
+		built_ = false;
+		return pattern_end_.size() - 1;
+	}
+
+	inline void multi_searcher::build()
+	{
+		// 0. pattern ids are kept in 32 bits (and the old table no longer matches the classes if it throws below)
+		built_ = false;
+		if (pattern_end_.size() > UINT32_MAX)
+		{
+			throw std::length_error("too many patterns for tvj::multi_searcher");
+		}
+
+		// 1. byte classes
+		bool used__[256] = { false };
+		for (size_t i = 0; i != pattern_text_.size(); i++)
+		{
+			used__[static_cast<unsigned char>(pattern_text_[i])] = true;
+		}
+		uint32_t classes_count__ = 0;
+		bool has_unused__ = false;
+		for (size_t c = 0; c != 256; c++) has_unused__ |= !used__[c];
+		if (has_unused__) classes_count__ = 1; // class 0 for all unused bytes
+		for (size_t c = 0; c != 256; c++)
+		{
+			classes_[c] = used__[c] ? static_cast<unsigned char>(classes_count__++) : 0;
+		}
+		stride_ = classes_count__;
+
+		// 2. the trie, rows are only filled with children here
+		vector<uint32_t> rows__(stride_, 0); // rows__[s * stride_ + c] is the child state, 0 if none
+		vector<uint32_t> terminal__;         // pattern id -> state
+		uint32_t states__ = 1;
+		for (size_t id = 0; id != pattern_end_.size(); id++)
+		{
+			const size_t begin__ = id ? pattern_end_[id - 1] : 0;
+			uint32_t state__ = 0;
+			for (size_t i = begin__; i != pattern_end_[id]; i++)
+			{
+				const size_t entry__ = static_cast<size_t>(state__) * stride_ + classes_[static_cast<unsigned char>(pattern_text_[i])];
+				if (!rows__[entry__])
+				{
+					if (static_cast<size_t>(states__) * stride_ > MULTI_SEARCHER_MAX_ENTRIES)
+					{
+						throw std::length_error("too many states for the transition table of tvj::multi_searcher");
+					}
+					rows__[entry__] = states__++;
+					for (uint32_t c = 0; c != stride_; c++) rows__.push_back(0);
+				}
+				state__ = rows__[entry__];
+			}
+			terminal__.push_back(state__);
+		}
+
+		// 3. own patterns of each state (empty patterns end at the root and are dropped)
+		out_begin_ = vector<uint32_t>(states__ + 1, 0, states__ + 2);
+		for (size_t id = 0; id != terminal__.size(); id++)
+		{
+			if (terminal__[id]) out_begin_[terminal__[id] + 1]++;
+		}
+		for (uint32_t s = 0; s != states__; s++) out_begin_[s + 1] += out_begin_[s];
+		out_ids_ = vector<uint32_t>(out_begin_[states__], 0, out_begin_[states__] + 1);
+		{
+			vector<uint32_t> filled__(states__, 0, states__ + 1);
+			for (size_t id = 0; id != terminal__.size(); id++)
+			{
+				const uint32_t state__ = terminal__[id];
+				if (state__) out_ids_[out_begin_[state__] + filled__[state__]++] = static_cast<uint32_t>(id);
+			}
+		}
+
+		// 4. failure links in breadth-first order, completing every row into a full transition
+		vector<uint32_t> fail__(states__, 0, states__ + 1);
+		dict_link_ = vector<uint32_t>(states__, 0, states__ + 1);
+		vector<uint32_t> queue__;
+		for (uint32_t c = 0; c != stride_; c++)
+		{
+			if (rows__[c]) queue__.push_back(rows__[c]);
+		}
+		for (size_t head__ = 0; head__ != queue__.size(); head__++)
+		{
+			const uint32_t state__ = queue__[head__];
+			const uint32_t fail_state__ = fail__[state__];
+			for (uint32_t c = 0; c != stride_; c++)
+			{
+				const uint32_t child__ = rows__[static_cast<size_t>(state__) * stride_ + c];
+				const uint32_t fallback__ = rows__[static_cast<size_t>(fail_state__) * stride_ + c];
+				if (child__)
+				{
+					fail__[child__] = fallback__;
+					dict_link_[child__] = out_begin_[fallback__] != out_begin_[fallback__ + 1] ? fallback__ : dict_link_[fallback__];
+					queue__.push_back(child__);
+				}
+				else
+				{
+					rows__[static_cast<size_t>(state__) * stride_ + c] = fallback__;
+				}
+			}
+		}
+
+		// 5. premultiplied entries with the report flag
+		table_ = vector<uint32_t>(rows__.size(), 0, rows__.size() + 1);
+		for (size_t i = 0; i != rows__.size(); i++)
+		{
+			const uint32_t target__ = rows__[i];
+			const bool reports__ = out_begin_[target__] != out_begin_[target__ + 1] || dict_link_[target__];
+			table_[i] = target__ * stride_ * 2 + (reports__ ? 1 : 0);
+		}
+		built_ = true;
+	}
+
+	inline size_t multi_searcher::size() const noexcept
+	{
+		return pattern_end_.size();
+	}
+
+	inline size_t multi_searcher::pattern_length(size_t pattern_id) const
+	{
+		return pattern_end_[pattern_id] - (pattern_id ? pattern_end_[pattern_id - 1] : 0);
+	}
+
+	template<typename Func>
+	inline void multi_searcher::for_each_match(const char* text, size_t length, Func func) const
+	{
+#ifndef NDEBUG
+		if (!built_) throw std::logic_error("search with tvj::multi_searcher before function build is called");
+#endif
+		const uint32_t* table__ = &table_[0];
+		const unsigned char* text__ = reinterpret_cast<const unsigned char*>(text);
+		uint32_t entry__ = 0;
+		for (size_t i = 0; i != length; i++)
+		{
+			entry__ = table__[(entry__ >> 1) + classes_[text__[i]]];
+			if (entry__ & 1)
+			{
+				_report((entry__ >> 1) / stride_, i + 1, func);
+			}
+		}
+	}
+
+	template<typename Func>
+	inline void multi_searcher::_report(uint32_t state, size_t end, Func& func) const
+	{
+		while (state)
+		{
+			for (uint32_t i = out_begin_[state]; i != out_begin_[state + 1]; i++)
+			{
+				func(static_cast<size_t>(out_ids_[i]), end - pattern_length(out_ids_[i]));
+			}
+			state = dict_link_[state];
+		}
+	}
+
+	inline vector<multi_match> multi_searcher::find_all(const string& text) const
+	{
+		return find_all(text.data(), text.size());
+	}
+
+	inline vector<multi_match> multi_searcher::find_all(const char* text, size_t length) const
+	{
+		vector<multi_match> matches__;
+		for_each_match(text, length, [&matches__](size_t pattern_id, size_t offset)
+			{
+				multi_match match__;
+				match__.pattern_id_ = pattern_id;
+				match__.offset_ = offset;
+				matches__.push_back(match__);
+			});
+		return matches__;
+	}
+
+	inline size_t multi_searcher::count(const string& text) const
+	{
+		return count(text.data(), text.size());
+	}
+
+	inline size_t multi_searcher::count(const char* text, size_t length) const
+	{
+		size_t count__ = 0;
+		for_each_match(text, length, [&count__](size_t, size_t) { count__++; });
+		return count__;
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
@@ -0,0 +1,256 @@
+/*
+ * File: TVJ_Node_Pool.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ *
+ * @version 1.2 2026/10/18
+ * - the next slab is twice the largest one so far, so a small reserve does not restart the growth
+ *
+ * @version 1.1 2026/10/18
+ * - add function reserve
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace tvj
+{
+#define NODE_POOL_FIRST_SLAB 32  // the number of nodes in the first slab
+#define NODE_POOL_MAX_SLAB 4096  // each next slab is twice as large as the largest one so far, up to this number of nodes
+
+	// an arena of nodes of one type,
+	// a node is carved from the current slab by bumping an index, a destroyed one goes to a free list for reuse,
+	// and all the slabs are released together with the pool,
+	// one pool can be shared by several containers of the same node type (but not by several threads)
+	template<typename Node>
+	class node_pool
+	{
+	public:
+
+		/**
+		 * brief: default constructor (no slab is allocated until the first node)
+		 * param: (void)
+		 * return: --
+		 */
+		node_pool() noexcept = default;
+
+		node_pool(const node_pool&) = delete;
+		node_pool& operator=(const node_pool&) = delete;
+
+		/**
+		 * brief: destructor, release all the slabs
+		 *        (the nodes still alive are not destructed)
+		 * param: (void)
+		 * return: --
+		 */
+		~node_pool();
+
+		/**
+		 * brief: construct a node in the pool
+		 * param: the arguments of the constructor
+		 * return: the node
+		 */
+		template<typename... Args>
+		Node* create(Args&&... args);
+
+		/**
+		 * brief: destruct a node created by this pool and keep its room for reuse
+		 * param: the node
+		 * return: void
+		 */
+		void destroy(Node* node) noexcept;
+
+		/**
+		 * brief: the number of nodes alive
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: the number of nodes the slabs can hold
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t capacity() const noexcept;
+
+		/**
+		 * brief: make room for a number of nodes with at most one more slab,
+		 *        so that creating them allocates nothing
+		 * param: the number of nodes
+		 * return: void
+		 */
+		void reserve(size_t count);
+
+		/**
+		 * brief: release all the slabs at once
+		 *        (the nodes still alive are not destructed and must not be used any more)
+		 * param: (void)
+		 * return: void
+		 */
+		void release() noexcept;
+
+	private:
+
+		// the room for a node, or the link of the free list once it is destroyed
+		union _cell
+		{
+			_cell* next_;
+			alignas(Node) unsigned char storage_[sizeof(Node)];
+		};
+
+		struct _slab
+		{
+			_slab* next_;
+			_cell* cells_;
+		};
+
+		/**
+		 * brief: allocate a new slab to carve the next nodes from
+		 * param: the number of cells in it
+		 * return: void
+		 */
+		void _add_slab(size_t size);
+
+		// the newest slab first
+		_slab* slabs_ = nullptr;
+
+		// the number of cells in the newest slab and how many of them are taken
+		size_t slab_size_ = 0;
+		size_t used_ = 0;
+
+		// the number of cells in the largest slab
+		size_t largest_slab_ = 0;
+
+		// the cells of the destroyed nodes
+		_cell* free_ = nullptr;
+
+		size_t size_ = 0;
+		size_t capacity_ = 0;
+	};
+
+	template<typename Node>
+	inline node_pool<Node>::~node_pool()
+	{
+		release();
+	}
+
+	template<typename Node>
+	template<typename... Args>
+	inline Node* node_pool<Node>::create(Args&&... args)
+	{
+		_cell* cell__;
+		if (free_)
+		{
+			cell__ = free_;
+			free_ = free_->next_;
+		}
+		else
+		{
+			if (used_ == slab_size_)
+			{
+				_add_slab(slabs_ ? (largest_slab_ < NODE_POOL_MAX_SLAB / 2 ? largest_slab_ << 1 : NODE_POOL_MAX_SLAB) : NODE_POOL_FIRST_SLAB);
+			}
+			cell__ = slabs_->cells_ + used_++;
+		}
+		Node* node__;
+		try
+		{
+			node__ = ::new (static_cast<void*>(cell__->storage_)) Node(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			cell__->next_ = free_;
+			free_ = cell__;
+			throw;
+		}
+		size_++;
+		return node__;
+	}
+
+	template<typename Node>
+	inline void node_pool<Node>::destroy(Node* node) noexcept
+	{
+		if (!node) return;
+		node->~Node();
+		_cell* cell__ = reinterpret_cast<_cell*>(node);
+		cell__->next_ = free_;
+		free_ = cell__;
+		size_--;
+	}
+
+	template<typename Node>
+	inline size_t node_pool<Node>::size() const noexcept
+	{
+		return size_;
+	}
+
+	template<typename Node>
+	inline size_t node_pool<Node>::capacity() const noexcept
+	{
+		return capacity_;
+	}
+
+	template<typename Node>
+	inline void node_pool<Node>::reserve(size_t count)
+	{
+		// the free cells are those on the free list and those never taken from the newest slab
+		if (capacity_ - size_ >= count) return;
+		const size_t more__ = count - (capacity_ - size_);
+		// only the newest slab is carved, so the rest of it goes to the free list (used before the new slab)
+		while (used_ != slab_size_)
+		{
+			_cell* cell__ = slabs_->cells_ + used_++;
+			cell__->next_ = free_;
+			free_ = cell__;
+		}
+		_add_slab(more__);
+	}
+
+	template<typename Node>
+	inline void node_pool<Node>::_add_slab(size_t size)
+	{
+		_slab* slab__ = new _slab;
+		try
+		{
+			slab__->cells_ = new _cell[size];
+		}
+		catch (...)
+		{
+			delete slab__;
+			throw;
+		}
+		slab__->next_ = slabs_;
+		slabs_ = slab__;
+		slab_size_ = size;
+		if (size > largest_slab_) largest_slab_ = size;
+		used_ = 0;
+		capacity_ += size;
+	}
+
+	template<typename Node>
+	inline void node_pool<Node>::release() noexcept
+	{
+		while (slabs_)
+		{
+			_slab* next__ = slabs_->next_;
+			delete[] slabs_->cells_;
+			delete slabs_;
+			slabs_ = next__;
+		}
+		slab_size_ = used_ = largest_slab_ = size_ = capacity_ = 0;
+		free_ = nullptr;
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
@@ -0,0 +1,298 @@
+/*
+ * File: TVJ_Number.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_String.h 1.9, TVJ_String_IO.h 1.0, TVJ_String_Builder.h 1.0, TVJ_String_View.h 1.0
+ *
+ * @version 1.3 2026/10/18
+ * - bug fix: to_chars without std::to_chars wrote subnormal values with more digits than needed
+ *
+ * @version 1.2 2026/10/18
+ * - from_chars of floating-point numbers without std::from_chars fails on numbers cut by its buffer,
+ *   on values out of range, and reads '+' and "0x" as std::from_chars does
+ *
+ * @version 1.1 2026/10/18
+ * - add to_chars of long double (a long double argument was ambiguous between double and float)
+ * - from_chars of long double reads it by strtold without std::from_chars
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <charconv>
+#endif
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define TVJ_NUMBER_STD_CHARCONV // shortest round-trip floating-point conversion from the standard library
+#endif
+#include "TVJ_String.h"
+#include "TVJ_String_IO.h"
+#include "TVJ_String_Builder.h"
+#include "TVJ_String_View.h"
+
+namespace tvj
+{
+#define NUMBER_MAX_CHARS 32 // no number takes more chars than this
+
+	/**
+	 * brief: write the digits of an unsigned integer, two at a time
+	 * param: where to write (room for 20 chars) and the value
+	 * return: one past the last char written
+	 */
+	inline char* _write_unsigned(char* out, unsigned long long value) noexcept
+	{
+		static const char digits__[] =
+			"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+			"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+		char buffer__[20];
+		char* p = buffer__ + 20;
+		while (value >= 100)
+		{
+			const unsigned pair__ = static_cast<unsigned>(value % 100) * 2;
+			value /= 100;
+			*--p = digits__[pair__ + 1];
+			*--p = digits__[pair__];
+		}
+		if (value >= 10)
+		{
+			*--p = digits__[value * 2 + 1];
+			*--p = digits__[value * 2];
+		}
+		else *--p = static_cast<char>('0' + value);
+		const size_t length__ = static_cast<size_t>(buffer__ + 20 - p);
+		memcpy(out, p, length__);
+		return out + length__;
+	}
+
+	/**
+	 * brief: write an integer in decimal
+	 * param: where to write (room for NUMBER_MAX_CHARS chars) and the value
+	 * return: one past the last char written
+	 */
+	template<typename Int>
+	inline typename std::enable_if<std::is_integral<Int>::value && !std::is_same<Int, bool>::value, char*>::type
+		to_chars(char* out, Int value) noexcept
+	{
+		if (value < 0)
+		{
+			*out++ = '-';
+			// negate in unsigned so that the minimum value does not overflow
+			return _write_unsigned(out, 0ull - static_cast<unsigned long long>(value));
+		}
+		return _write_unsigned(out, static_cast<unsigned long long>(value));
+	}
+
+	/**
+	 * brief: write a floating-point number with the fewest digits that read back to the same value
+	 *        (std::to_chars if available, otherwise the shortest of 15 to 17 significant digits, from 1 for subnormal values)
+	 * param: where to write (room for NUMBER_MAX_CHARS chars) and the value
+	 * return: one past the last char written
+	 */
+	inline char* to_chars(char* out, double value) noexcept
+	{
+#ifdef TVJ_NUMBER_STD_CHARCONV
+		return std::to_chars(out, out + NUMBER_MAX_CHARS, value).ptr;
+#else
+		// fewer digits than 15 only read back if they are those of %.15g, but for subnormal values
+		const bool subnormal__ = value != 0 && value < std::numeric_limits<double>::min() && value > -std::numeric_limits<double>::min();
+		int length__ = 0;
+		for (int precision = subnormal__ ? 1 : 15; precision <= 17; precision++)
+		{
+			length__ = std::snprintf(out, NUMBER_MAX_CHARS, "%.*g", precision, value);
+			if (value != value || std::strtod(out, nullptr) == value) break; // nan never compares equal
+		}
+		return out + length__;
+#endif
+	}
+
+	/**
+	 * brief: write a float with the fewest digits that read back to the same value
+	 * param: where to write (room for NUMBER_MAX_CHARS chars) and the value
+	 * return: one past the last char written
+	 */
+	inline char* to_chars(char* out, float value) noexcept
+	{
+#ifdef TVJ_NUMBER_STD_CHARCONV
+		return std::to_chars(out, out + NUMBER_MAX_CHARS, value).ptr;
+#else
+		const bool subnormal__ = value != 0 && value < std::numeric_limits<float>::min() && value > -std::numeric_limits<float>::min();
+		int length__ = 0;
+		for (int precision = subnormal__ ? 1 : 6; precision <= 9; precision++)
+		{
+			length__ = std::snprintf(out, NUMBER_MAX_CHARS, "%.*g", precision, static_cast<double>(value));
+			if (value != value || std::strtof(out, nullptr) == value) break;
+		}
+		return out + length__;
+#endif
+	}
+
+	/**
+	 * brief: write a long double with the fewest digits that read back to the same value
+	 * param: where to write (room for NUMBER_MAX_CHARS chars) and the value
+	 * return: one past the last char written
+	 */
+	inline char* to_chars(char* out, long double value) noexcept
+	{
+#ifdef TVJ_NUMBER_STD_CHARCONV
+		return std::to_chars(out, out + NUMBER_MAX_CHARS, value).ptr;
+#else
+		const bool subnormal__ = value != 0 && value < std::numeric_limits<long double>::min() && value > -std::numeric_limits<long double>::min();
+		int length__ = 0;
+		for (int precision = subnormal__ ? 1 : std::numeric_limits<long double>::digits10; precision <= std::numeric_limits<long double>::max_digits10; precision++)
+		{
+			length__ = std::snprintf(out, NUMBER_MAX_CHARS, "%.*Lg", precision, value);
+			if (value != value || std::strtold(out, nullptr) == value) break;
+		}
+		return out + length__;
+#endif
+	}
+
+	/**
+	 * brief: read an integer in decimal (with an optional '-' for signed types)
+	 * param: the chars [first, last) and the value (unchanged on failure)
+	 * return: one past the last char read, nullptr if there is no number or it overflows
+	 */
+	template<typename Int>
+	inline typename std::enable_if<std::is_integral<Int>::value && !std::is_same<Int, bool>::value, const char*>::type
+		from_chars(const char* first, const char* last, Int& value) noexcept
+	{
+		typedef typename std::make_unsigned<Int>::type Unsigned;
+		const bool negative__ = std::is_signed<Int>::value && first != last && *first == '-';
+		const char* p = first + negative__;
+		const Unsigned limit__ = negative__
+			? static_cast<Unsigned>(static_cast<Unsigned>(std::numeric_limits<Int>::max()) + 1)
+			: static_cast<Unsigned>(std::numeric_limits<Int>::max());
+		Unsigned result__ = 0;
+		const char* digits__ = p;
+		for (; p != last && *p >= '0' && *p <= '9'; p++)
+		{
+			const unsigned digit__ = static_cast<unsigned>(*p - '0');
+			if (result__ > (limit__ - digit__) / 10) return nullptr;
+			result__ = static_cast<Unsigned>(result__ * 10 + digit__);
+		}
+		if (p == digits__) return nullptr;
+		value = negative__ ? static_cast<Int>(0 - result__) : static_cast<Int>(result__);
+		return p;
+	}
+
+	/**
+	 * brief: read a floating-point number (std::from_chars if available, otherwise strtod),
+	 *        in the grammar of std::from_chars: no leading whitespace or '+', and "0x" is read as 0;
+	 *        strtod uses the decimal point of the C locale in effect, std::from_chars always '.'
+	 * param: the chars [first, last) and the value (unchanged on failure)
+	 * return: one past the last char read, nullptr if there is no number, it is out of range
+	 *         or (without std::from_chars) it is longer than NUMBER_MAX_CHARS * 4 - 1 chars
+	 */
+	template<typename Float>
+	inline typename std::enable_if<std::is_floating_point<Float>::value, const char*>::type
+		from_chars(const char* first, const char* last, Float& value) noexcept
+	{
+#ifdef TVJ_NUMBER_STD_CHARCONV
+		const std::from_chars_result result__ = std::from_chars(first, last, value);
+		return result__.ec == std::errc() ? result__.ptr : nullptr;
+#else
+		// strtod needs a '\0' at the end, so a bounded copy is read instead
+		char buffer__[NUMBER_MAX_CHARS * 4];
+		const bool truncated__ = static_cast<size_t>(last - first) > sizeof(buffer__) - 1;
+		size_t length__ = truncated__ ? sizeof(buffer__) - 1 : static_cast<size_t>(last - first);
+		if (length__ == 0 || *first == '+' || std::isspace(static_cast<unsigned char>(*first))) return nullptr;
+		const size_t sign__ = *first == '-';
+		if (length__ > sign__ + 1 && first[sign__] == '0' && (first[sign__ + 1] == 'x' || first[sign__ + 1] == 'X'))
+		{
+			length__ = sign__ + 1; // strtod would read it as hexadecimal
+		}
+		memcpy(buffer__, first, length__);
+		buffer__[length__] = 0;
+		char* end__ = nullptr;
+		errno = 0;
+		const Float result__ = std::is_same<Float, float>::value ? static_cast<Float>(std::strtof(buffer__, &end__))
+			: std::is_same<Float, double>::value ? static_cast<Float>(std::strtod(buffer__, &end__)) : static_cast<Float>(std::strtold(buffer__, &end__));
+		if (end__ == buffer__ || (truncated__ && end__ == buffer__ + length__)) return nullptr;
+		// out of range, but subnormal values are kept as std::from_chars does
+		if (errno == ERANGE && (result__ == 0 || result__ == std::numeric_limits<Float>::infinity() || result__ == -std::numeric_limits<Float>::infinity())) return nullptr;
+		value = result__;
+		return first + (end__ - buffer__);
+#endif
+	}
+
+	/**
+	 * brief: read a number that takes up the whole text
+	 * param: the text and the value (unchanged on failure)
+	 * return: bool
+	 */
+	template<typename Number>
+	inline bool from_chars(const string_view& text, Number& value) noexcept
+	{
+		Number result__;
+		if (from_chars(text.begin(), text.end(), result__) != text.end()) return false;
+		value = result__;
+		return true;
+	}
+
+	/**
+	 * brief: append a number to the end of a string, written in place
+	 * param: the string and the number
+	 * return: string (read & write)
+	 */
+	template<typename Number>
+	inline string& append_number(string& str, Number value)
+	{
+		char* tail__ = _string_io::_tail(str, NUMBER_MAX_CHARS);
+		_string_io::_commit(str, static_cast<size_t>(to_chars(tail__, value) - tail__));
+		return str;
+	}
+
+	/**
+	 * brief: append a number to the end of a string builder
+	 * param: the string builder and the number
+	 * return: string_builder (read & write)
+	 */
+	template<typename Number>
+	inline string_builder& append_number(string_builder& builder, Number value)
+	{
+		char buffer__[NUMBER_MAX_CHARS];
+		return builder.append(buffer__, static_cast<size_t>(to_chars(buffer__, value) - buffer__));
+	}
+
+	/**
+	 * brief: operator <<, append a number (not a char) to a string builder
+	 * param: the string builder and the number
+	 * return: string_builder (read & write)
+	 */
+	template<typename Number>
+	inline typename std::enable_if<std::is_arithmetic<Number>::value && !std::is_same<Number, char>::value && !std::is_same<Number, bool>::value,
+		string_builder&>::type operator<<(string_builder& builder, Number value)
+	{
+		return append_number(builder, value);
+	}
+
+	/**
+	 * brief: the decimal form of a number
+	 * param: the number
+	 * return: string
+	 */
+	template<typename Number>
+	inline string to_string(Number value)
+	{
+		string ret;
+		append_number(ret, value);
+		return ret;
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
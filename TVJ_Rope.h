@@ -0,0 +1,785 @@
+/*
+ * File: TVJ_Rope.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_String.h 1.4, TVJ_Stack.h 1.0
+ *
+ * @version 1.2 2026/10/18
+ * - each chunk only allocates the room of its chars (growing up to ROPE_CHUNK_SIZE)
+ * - neighbouring chunks that fit in one are joined when two trees are merged (e.g. by erase)
+ * - split keeps the treap priorities in heap order
+ * - fix the copy assignment not copying the seed
+ * 
+ * @version 1.1 2026/10/18
+ * - use function data of tvj::string
+ * 
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstring>
+#include <iostream>
+#include "TVJ_String.h"
+#include "TVJ_Stack.h"
+
+namespace tvj
+{
+	// a piece of the rope (valid until the rope is changed)
+	struct rope_chunk
+	{
+		const char* data_ = nullptr;
+		size_t size_ = 0;
+	};
+
+	// a text stored as a balanced tree (treap) of chunks,
+	// so insert, erase, concat and split take O(log n) instead of moving the whole tail
+	class rope
+	{
+	public:
+
+#define ROPE_CHUNK_SIZE 1024 // the maximum capacity of each chunk
+
+	protected:
+		struct Rope_Node
+		{
+			Rope_Node(unsigned priority, size_t capacity);
+			~Rope_Node();
+			char* data_;
+			size_t capacity_;     // the room of data_ (no more than ROPE_CHUNK_SIZE)
+			size_t length_ = 0;   // the number of chars in this chunk
+			size_t total_ = 0;    // the number of chars in this subtree
+			unsigned priority_;   // the treap priority (the parent is no smaller)
+			Rope_Node* L_child_ = nullptr, * R_child_ = nullptr;
+		};
+
+	public:
+		class chunk_iterator
+		{
+			friend class rope;
+
+		public:
+			// @ functions providing limited access
+			rope_chunk operator*() const;
+			chunk_iterator& operator++();
+			chunk_iterator operator++(int);
+			bool operator==(const chunk_iterator& iter) const noexcept;
+			bool operator!=(const chunk_iterator& iter) const noexcept;
+
+		protected:
+			chunk_iterator(Rope_Node* root);
+
+			/**
+			 * brief: go down to the leftmost node of the subtree and remember the path,
+			 *        then the leftmost node becomes the current one
+			 * param: the root of the subtree
+			 * return: void
+			 */
+			void _push_left(Rope_Node* node);
+
+			// the ancestors still to be visited
+			stack<Rope_Node*> path_;
+
+			// the node of the current chunk, nullptr for the end
+			Rope_Node* current_ = nullptr;
+		};
+
+		/**
+		 * brief: default constructor
+		 * param: (void)
+		 * return: --
+		 */
+		rope();
+
+		/**
+		 * brief: constructor
+		 * param: the text
+		 * return: --
+		 */
+		rope(const string& str);
+
+		/**
+		 * brief: constructor
+		 * param: the text and its length
+		 * return: --
+		 */
+		rope(const char* str, size_t length);
+
+		/**
+		 * brief: copy constructor
+		 * param: another rope
+		 * return: --
+		 */
+		rope(const rope& another);
+
+		/**
+		 * brief: move constructor
+		 * param: another rope (left empty)
+		 * return: --
+		 */
+		rope(rope&& another) noexcept;
+
+		/**
+		 * brief: destructor
+		 * param: (void)
+		 * return: --
+		 */
+		~rope();
+
+		/**
+		 * brief: copy
+		 * param: another rope
+		 * return: the copied rope (read & write)
+		 */
+		rope& operator=(const rope& another);
+
+		/**
+		 * brief: move
+		 * param: another rope (left empty)
+		 * return: the rope (read & write)
+		 */
+		rope& operator=(rope&& another) noexcept;
+
+		/**
+		 * brief: the number of chars
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: the number of chars, the alias of size
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t length() const noexcept;
+
+		/**
+		 * brief: check if the rope is empty
+		 * param: (void)
+		 * return: bool
+		 */
+		bool empty() const noexcept;
+
+		/**
+		 * brief: remove all chars
+		 * param: (void)
+		 * return: void
+		 */
+		void clear() noexcept;
+
+		/**
+		 * brief: the char at the certain index, O(log n)
+		 * param: size_t index
+		 * return: char
+		 */
+		char at(size_t index) const;
+
+		/**
+		 * brief: the char at the certain index, O(log n)
+		 * param: size_t index
+		 * return: char
+		 */
+		char operator[](size_t index) const;
+
+		/**
+		 * brief: insert text before a certain index (the size means at the end)
+		 * param: the index, the text and its length
+		 * return: the rope itself
+		 */
+		rope& insert(size_t index, const char* str, size_t length);
+
+		/**
+		 * brief: insert text before a certain index (the size means at the end)
+		 * param: the index and the text
+		 * return: the rope itself
+		 */
+		rope& insert(size_t index, const string& str);
+
+		/**
+		 * brief: append text at the end
+		 * param: the text and its length
+		 * return: the rope itself
+		 */
+		rope& append(const char* str, size_t length);
+
+		/**
+		 * brief: append text at the end
+		 * param: the text
+		 * return: the rope itself
+		 */
+		rope& append(const string& str);
+
+		/**
+		 * brief: append char at the end
+		 * param: char
+		 * return: the rope itself
+		 */
+		rope& append(const char& ch);
+
+		/**
+		 * brief: remove chars in range [index, index + count)
+		 * param: the index and the number of chars
+		 * return: the rope itself
+		 */
+		rope& erase(size_t index, size_t count);
+
+		/**
+		 * brief: move all chars of another rope to the end of this one, O(log n)
+		 * param: another rope (left empty)
+		 * return: the rope itself
+		 */
+		rope& concat(rope& another);
+
+		/**
+		 * brief: split at a certain index, this keeps [0, index), O(log n)
+		 * param: the index
+		 * return: the rope of [index, size)
+		 */
+		rope split(size_t index);
+
+		/**
+		 * brief: the flat string (copied once)
+		 * param: (void)
+		 * return: string
+		 */
+		string to_string() const;
+
+		/**
+		 * @ iterators over the chunks in order, no char is copied
+		 * @ chunk_cbegin is the iterator pointing to the first chunk
+		 * @ chunk_cend is the iterator pointing to one past the last chunk
+		 *   (an iterator holds a stack, so keep chunk_cend out of the loop condition)
+		 */
+		chunk_iterator chunk_cbegin() const;
+		chunk_iterator chunk_cend() const;
+
+	protected:
+
+		/**
+		 * brief: a new node with a random priority
+		 * param: the room of the chunk
+		 * return: Rope_Node*
+		 */
+		Rope_Node* _new_node(size_t capacity);
+
+		/**
+		 * brief: make room for chars of the certain number in the chunk of a node,
+		 *        the room at least doubles (up to ROPE_CHUNK_SIZE) so appending chars one by one stays cheap
+		 * param: the node and the number of chars (no more than ROPE_CHUNK_SIZE)
+		 * return: void
+		 */
+		static void _reserve(Rope_Node* node, size_t length);
+
+		/**
+		 * brief: nodes holding the text, merged into one treap
+		 * param: the text and its length
+		 * return: the root
+		 */
+		Rope_Node* _build(const char* str, size_t length);
+
+		/**
+		 * brief: insert into the chunk containing the index if it has room
+		 * param: the subtree, the index (in the subtree), the text and its length
+		 * return: bool, whether it is inserted
+		 */
+		static bool _insert_in_place(Rope_Node* node, size_t index, const char* str, size_t length);
+
+		/**
+		 * brief: split a subtree, the chunk containing the index is cut in two
+		 * param: the subtree, the index, the left and the right part
+		 * return: void
+		 */
+		void _split(Rope_Node* node, size_t index, Rope_Node*& left, Rope_Node*& right);
+
+		/**
+		 * brief: merge two subtrees, all chars of the left one come first,
+		 *        the last chunk of the left one and the first chunk of the right one are joined if they fit in one
+		 * param: the left and the right subtree
+		 * return: the root
+		 */
+		static Rope_Node* _merge(Rope_Node* left, Rope_Node* right);
+
+		/**
+		 * brief: merge two subtrees by the priorities, all chars of the left one come first
+		 * param: the left and the right subtree
+		 * return: the root
+		 */
+		static Rope_Node* _join(Rope_Node* left, Rope_Node* right);
+
+		/**
+		 * brief: recompute total_ from the children
+		 * param: the node
+		 * return: void
+		 */
+		static void _update(Rope_Node* node) noexcept;
+
+		/**
+		 * brief: total_ of the subtree, 0 for nullptr
+		 * param: the node
+		 * return: size_t
+		 */
+		static size_t _total(const Rope_Node* node) noexcept;
+
+		/**
+		 * brief: delete a subtree
+		 * param: the root of the subtree
+		 * return: void
+		 */
+		static void _destroy(Rope_Node* node) noexcept;
+
+		/**
+		 * brief: copy a subtree
+		 * param: the root of the subtree
+		 * return: the root of the copy
+		 */
+		static Rope_Node* _copy(const Rope_Node* node);
+
+		Rope_Node* root_ = nullptr;
+
+		// the state of the xorshift generator for priorities
+		unsigned seed_ = 2463534242u;
+	};
+
+	inline rope::Rope_Node::Rope_Node(unsigned priority, size_t capacity)
+		: data_(new char[capacity]), capacity_(capacity), priority_(priority) { }
+
+	inline rope::Rope_Node::~Rope_Node()
+	{
+		delete[] data_;
+	}
+
+	inline rope::chunk_iterator::chunk_iterator(Rope_Node* root)
+	{
+		_push_left(root);
+	}
+
+	inline void rope::chunk_iterator::_push_left(Rope_Node* node)
+	{
+		while (node)
+		{
+			path_.push(node);
+			node = node->L_child_;
+		}
+		current_ = path_.empty() ? nullptr : path_.pop();
+	}
+
+	inline rope_chunk rope::chunk_iterator::operator*() const
+	{
+		rope_chunk chunk__;
+		chunk__.data_ = current_->data_;
+		chunk__.size_ = current_->length_;
+		return chunk__;
+	}
+
+	inline rope::chunk_iterator& rope::chunk_iterator::operator++()
+	{
+		_push_left(current_->R_child_);
+		return *this;
+	}
+
+	inline rope::chunk_iterator rope::chunk_iterator::operator++(int)
+	{
+		chunk_iterator ret = *this;
+		++*this;
+		return ret;
+	}
+
+	inline bool rope::chunk_iterator::operator==(const chunk_iterator& iter) const noexcept
+	{
+		return current_ == iter.current_;
+	}
+
+	inline bool rope::chunk_iterator::operator!=(const chunk_iterator& iter) const noexcept
+	{
+		return !(*this == iter);
+	}
+
+	inline rope::rope() { }
+
+	inline rope::rope(const string& str)
+	{
+		root_ = _build(str.data(), str.size());
+	}
+
+	inline rope::rope(const char* str, size_t length)
+	{
+		root_ = _build(str, length);
+	}
+
+	inline rope::rope(const rope& another)
+		: root_(_copy(another.root_)), seed_(another.seed_) { }
+
+	inline rope::rope(rope&& another) noexcept
+		: root_(another.root_), seed_(another.seed_)
+	{
+		another.root_ = nullptr;
+	}
+
+	inline rope::~rope()
+	{
+		_destroy(root_);
+	}
+
+	inline rope& rope::operator=(const rope& another)
+	{
+		if (this != &another)
+		{
+			Rope_Node* copy__ = _copy(another.root_);
+			_destroy(root_);
+			root_ = copy__;
+			seed_ = another.seed_;
+		}
+		return *this;
+	}
+
+	inline rope& rope::operator=(rope&& another) noexcept
+	{
+		if (this != &another)
+		{
+			_destroy(root_);
+			root_ = another.root_;
+			another.root_ = nullptr;
+		}
+		return *this;
+	}
+
+	inline size_t rope::size() const noexcept
+	{
+		return _total(root_);
+	}
+
+	inline size_t rope::length() const noexcept
+	{
+		return _total(root_);
+	}
+
+	inline bool rope::empty() const noexcept
+	{
+		return !root_;
+	}
+
+	inline void rope::clear() noexcept
+	{
+		_destroy(root_);
+		root_ = nullptr;
+	}
+
+	inline char rope::at(size_t index) const
+	{
+#ifndef NDEBUG
+		if (index >= size()) error_info("Overflow in at of tvj::rope", TVJ_STRING_OVERFLOW);
+#endif
+		const Rope_Node* node__ = root_;
+		while (true)
+		{
+			const size_t left__ = _total(node__->L_child_);
+			if (index < left__)
+			{
+				node__ = node__->L_child_;
+			}
+			else if (index < left__ + node__->length_)
+			{
+				return node__->data_[index - left__];
+			}
+			else
+			{
+				index -= left__ + node__->length_;
+				node__ = node__->R_child_;
+			}
+		}
+	}
+
+	inline char rope::operator[](size_t index) const
+	{
+		return at(index);
+	}
+
+	inline rope& rope::insert(size_t index, const char* str, size_t length)
+	{
+#ifndef NDEBUG
+		if (index > size()) error_info("Overflow in insert of tvj::rope", TVJ_STRING_OVERFLOW);
+#endif
+		if (length == 0) return *this;
+		if (length <= ROPE_CHUNK_SIZE && _insert_in_place(root_, index, str, length)) return *this;
+		Rope_Node* left__, * right__;
+		_split(root_, index, left__, right__);
+		root_ = _merge(_merge(left__, _build(str, length)), right__);
+		return *this;
+	}
+
+	inline rope& rope::insert(size_t index, const string& str)
+	{
+		return insert(index, str.data(), str.size());
+	}
+
+	inline rope& rope::append(const char* str, size_t length)
+	{
+		return insert(size(), str, length);
+	}
+
+	inline rope& rope::append(const string& str)
+	{
+		return insert(size(), str.data(), str.size());
+	}
+
+	inline rope& rope::append(const char& ch)
+	{
+		return insert(size(), &ch, 1);
+	}
+
+	inline rope& rope::erase(size_t index, size_t count)
+	{
+#ifndef NDEBUG
+		if (index + count > size()) error_info("Overflow in erase of tvj::rope", TVJ_STRING_OVERFLOW);
+#endif
+		if (count == 0) return *this;
+		Rope_Node* left__, * middle__, * right__;
+		_split(root_, index, left__, middle__);
+		_split(middle__, count, middle__, right__);
+		_destroy(middle__);
+		root_ = _merge(left__, right__);
+		return *this;
+	}
+
+	inline rope& rope::concat(rope& another)
+	{
+		if (this != &another)
+		{
+			root_ = _merge(root_, another.root_);
+			another.root_ = nullptr;
+		}
+		return *this;
+	}
+
+	inline rope rope::split(size_t index)
+	{
+#ifndef NDEBUG
+		if (index > size()) error_info("Overflow in split of tvj::rope", TVJ_STRING_OVERFLOW);
+#endif
+		rope ret;
+		ret.seed_ = seed_ ^ 0x9E3779B9u;
+		_split(root_, index, root_, ret.root_);
+		return ret;
+	}
+
+	inline string rope::to_string() const
+	{
+		const size_t size__ = size();
+		string ret(size__, '\0', size__ + 1);
+		size_t written__ = 0;
+		const chunk_iterator end__ = chunk_cend();
+		for (auto iter__ = chunk_cbegin(); iter__ != end__; ++iter__)
+		{
+			const rope_chunk chunk__ = *iter__;
+			std::memcpy(ret.data() + written__, chunk__.data_, chunk__.size_);
+			written__ += chunk__.size_;
+		}
+		return ret;
+	}
+
+	inline rope::chunk_iterator rope::chunk_cbegin() const
+	{
+		return chunk_iterator(root_);
+	}
+
+	inline rope::chunk_iterator rope::chunk_cend() const
+	{
+		return chunk_iterator(nullptr);
+	}
+
+	inline rope::Rope_Node* rope::_new_node(size_t capacity)
+	{
+		// xorshift32
+		seed_ ^= seed_ << 13;
+		seed_ ^= seed_ >> 17;
+		seed_ ^= seed_ << 5;
+		return new Rope_Node(seed_, capacity);
+	}
+
+	inline void rope::_reserve(Rope_Node* node, size_t length)
+	{
+		if (length <= node->capacity_) return;
+		size_t capacity__ = node->capacity_ * 2 < ROPE_CHUNK_SIZE ? node->capacity_ * 2 : ROPE_CHUNK_SIZE;
+		if (capacity__ < length) capacity__ = length;
+		char* data__ = new char[capacity__];
+		std::memcpy(data__, node->data_, node->length_);
+		delete[] node->data_;
+		node->data_ = data__;
+		node->capacity_ = capacity__;
+	}
+
+	inline rope::Rope_Node* rope::_build(const char* str, size_t length)
+	{
+		Rope_Node* root__ = nullptr;
+		for (size_t i = 0; i < length; i += ROPE_CHUNK_SIZE)
+		{
+			const size_t length__ = (length - i < ROPE_CHUNK_SIZE) ? length - i : ROPE_CHUNK_SIZE;
+			Rope_Node* node__ = _new_node(length__);
+			node__->length_ = node__->total_ = length__;
+			std::memcpy(node__->data_, str + i, node__->length_);
+			root__ = _join(root__, node__);
+		}
+		return root__;
+	}
+
+	inline bool rope::_insert_in_place(Rope_Node* node, size_t index, const char* str, size_t length)
+	{
+		if (!node) return false;
+		const size_t left__ = _total(node->L_child_);
+		bool inserted__ = false;
+		if (index < left__)
+		{
+			inserted__ = _insert_in_place(node->L_child_, index, str, length);
+		}
+		else if (index <= left__ + node->length_)
+		{
+			if (node->length_ + length > ROPE_CHUNK_SIZE) return false;
+			_reserve(node, node->length_ + length);
+			const size_t offset__ = index - left__;
+			std::memmove(node->data_ + offset__ + length, node->data_ + offset__, node->length_ - offset__);
+			std::memcpy(node->data_ + offset__, str, length);
+			node->length_ += length;
+			inserted__ = true;
+		}
+		else
+		{
+			inserted__ = _insert_in_place(node->R_child_, index - left__ - node->length_, str, length);
+		}
+		if (inserted__) node->total_ += length;
+		return inserted__;
+	}
+
+	inline void rope::_split(Rope_Node* node, size_t index, Rope_Node*& left, Rope_Node*& right)
+	{
+		if (!node)
+		{
+			left = right = nullptr;
+			return;
+		}
+		const size_t left_total__ = _total(node->L_child_);
+		if (index <= left_total__)
+		{
+			_split(node->L_child_, index, left, node->L_child_);
+			right = node;
+		}
+		else if (index >= left_total__ + node->length_)
+		{
+			_split(node->R_child_, index - left_total__ - node->length_, node->R_child_, right);
+			left = node;
+		}
+		else
+		{
+			// cut the chunk, the tail becomes a new node with the right subtree as its right child,
+			// it takes the priority of the node so it is no larger than any ancestor and no smaller than the right subtree
+			const size_t offset__ = index - left_total__;
+			Rope_Node* tail__ = new Rope_Node(node->priority_, node->length_ - offset__);
+			tail__->length_ = node->length_ - offset__;
+			std::memcpy(tail__->data_, node->data_ + offset__, tail__->length_);
+			tail__->R_child_ = node->R_child_;
+			_update(tail__);
+			node->length_ = offset__;
+			node->R_child_ = nullptr;
+			right = tail__;
+			left = node;
+		}
+		_update(node);
+	}
+
+	inline rope::Rope_Node* rope::_merge(Rope_Node* left, Rope_Node* right)
+	{
+		if (!left) return right;
+		if (!right) return left;
+		Rope_Node* last__ = left;
+		while (last__->R_child_) last__ = last__->R_child_;
+		Rope_Node* first__ = right;
+		while (first__->L_child_) first__ = first__->L_child_;
+		if (last__->length_ + first__->length_ <= ROPE_CHUNK_SIZE)
+		{
+			// move the chars of the first chunk of the right subtree to the last chunk of the left one
+			const size_t moved__ = first__->length_;
+			_reserve(last__, last__->length_ + moved__);
+			std::memcpy(last__->data_ + last__->length_, first__->data_, moved__);
+			last__->length_ += moved__;
+			for (Rope_Node* p = left; p; p = p->R_child_) p->total_ += moved__;
+
+			// and its right child takes its place
+			Rope_Node** link__ = &right;
+			while (*link__ != first__)
+			{
+				(*link__)->total_ -= moved__;
+				link__ = &(*link__)->L_child_;
+			}
+			*link__ = first__->R_child_;
+			first__->R_child_ = nullptr;
+			delete first__;
+		}
+		return _join(left, right);
+	}
+
+	inline rope::Rope_Node* rope::_join(Rope_Node* left, Rope_Node* right)
+	{
+		if (!left) return right;
+		if (!right) return left;
+		if (left->priority_ >= right->priority_)
+		{
+			left->R_child_ = _join(left->R_child_, right);
+			_update(left);
+			return left;
+		}
+		else
+		{
+			right->L_child_ = _join(left, right->L_child_);
+			_update(right);
+			return right;
+		}
+	}
+
+	inline void rope::_update(Rope_Node* node) noexcept
+	{
+		node->total_ = _total(node->L_child_) + node->length_ + _total(node->R_child_);
+	}
+
+	inline size_t rope::_total(const Rope_Node* node) noexcept
+	{
+		return node ? node->total_ : 0;
+	}
+
+	inline void rope::_destroy(Rope_Node* node) noexcept
+	{
+		if (!node) return;
+		_destroy(node->L_child_);
+		_destroy(node->R_child_);
+		delete node;
+	}
+
+	inline rope::Rope_Node* rope::_copy(const Rope_Node* node)
+	{
+		if (!node) return nullptr;
+		Rope_Node* copy__ = new Rope_Node(node->priority_, node->length_);
+		copy__->length_ = node->length_;
+		copy__->total_ = node->total_;
+		std::memcpy(copy__->data_, node->data_, node->length_);
+		copy__->L_child_ = _copy(node->L_child_);
+		copy__->R_child_ = _copy(node->R_child_);
+		return copy__;
+	}
+
+	inline std::ostream& operator<<(std::ostream& out, const rope& r)
+	{
+		const rope::chunk_iterator end__ = r.chunk_cend();
+		for (auto iter__ = r.chunk_cbegin(); iter__ != end__; ++iter__)
+		{
+			const rope_chunk chunk__ = *iter__;
+			out.write(chunk__.data_, chunk__.size_);
+		}
+		return out;
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
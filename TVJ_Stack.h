@@ -5,18 +5,58 @@
  * @author: Teddy van Jerry
  * @licence: The MIT Licence
  * @compiler: at least C++/11 (tested on MSVC and MinGW)
- * @reliance: TVJ_Vector.h version 1.1
+ * @reliance: TVJ_Vector.h version 1.8
  *
+ * @version 1.4 2026/10/18
+ * - bug fix: push and emplace with an element of the stack itself (e.g. push(top())) when it grows
+ * 
+ * @version 1.3 2026/10/18
+ * - emplace constructs the element in its slot instead of moving a temporary in
+ * - push of stack is no longer noexcept (it may allocate)
+ * 
+ * @version 1.2 2026/10/18
+ * - add segmented_stack, a stack of chained blocks that never relocates its elements
+ * 
+ * @version 1.1 2026/10/18
+ * - add push with an rvalue, emplace, and pop moves the element out
+ * - peak and top read the last element directly (also non-const overloads)
+ * - add inline_stack, a stack of fixed capacity without dynamic allocation
+ * 
  * @version 1.0 2021/03/25
  * - initial version
  *
  */
 
 #pragma once
+#include <new>
+#include <utility>
 #include "TVJ_Vector.h"
 
 namespace tvj
 {
+#define SEGMENTED_STACK_BLOCK_BYTES 4096 // the approximate size of each block of segmented_stack
+
+	/**
+	 * brief: construct an element in a slot of an array instead of the one there,
+	 *        which is default constructed again if the constructor throws
+	 * param: the slot and the arguments of the constructor
+	 * return: void
+	 */
+	template<typename Elem, typename... Args>
+	inline void _construct_in_slot(Elem* slot, Args&&... args)
+	{
+		slot->~Elem();
+		try
+		{
+			::new (static_cast<void*>(slot)) Elem(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			::new (static_cast<void*>(slot)) Elem();
+			throw;
+		}
+	}
+
 	template<typename Elem>
 	class stack : protected vector<Elem>
 	{
@@ -41,28 +81,47 @@ namespace tvj
 		 * param: the element
 		 * return: void
 		 */
-		void push(const Elem& elem) noexcept;
+		void push(const Elem& elem);
+
+		/**
+		 * brief: push an element into stack (moved in)
+		 * param: the element
+		 * return: void
+		 */
+		void push(Elem&& elem);
+
+		/**
+		 * brief: push an element constructed from the arguments
+		 * param: the arguments of the constructor
+		 * return: void
+		 */
+		template<typename... Args>
+		void emplace(Args&&... args);
 
 		/**
 		 * brief: pop an element from stack
 		 * param: the element
-		 * return: the removed element
+		 * return: the removed element (moved out)
 		 */
 		Elem pop();
 
 		/**
 		 * brief: peak the top element
+		 *        (this function is overloaded)
 		 * param: (void)
 		 * return: the top element
 		 */
-		const Elem& peak();
+		const Elem& peak() const;
+		Elem& peak();
 
 		/**
 		 * brief: peak the top element
+		 *        (this function is overloaded)
 		 * param: (void)
 		 * return: the top element
 		 */
-		const Elem& top();
+		const Elem& top() const;
+		Elem& top();
 
 		/**
 		 * brief: clear the stack
@@ -79,9 +138,45 @@ namespace tvj
 	}
 
 	template<typename Elem>
-	inline void stack<Elem>::push(const Elem& elem) noexcept
+	inline void stack<Elem>::push(const Elem& elem)
+	{
+		// not by push_back, which is noexcept, so that bad_alloc reaches the caller
+		if (this->size_ + 1 == this->capacity_)
+		{
+			// elem may be an element of this stack (e.g. push(top())), which _expand moves away and frees
+			Elem copy__(elem);
+			this->_expand();
+			this->_data()[this->size_++] = std::move(copy__);
+		}
+		else this->_data()[this->size_++] = elem;
+	}
+
+	template<typename Elem>
+	inline void stack<Elem>::push(Elem&& elem)
+	{
+		if (this->size_ + 1 == this->capacity_)
+		{
+			Elem moved__(std::move(elem));
+			this->_expand();
+			this->_data()[this->size_++] = std::move(moved__);
+		}
+		else this->_data()[this->size_++] = std::move(elem);
+	}
+
+	template<typename Elem>
+	template<typename... Args>
+	inline void stack<Elem>::emplace(Args&&... args)
 	{
-		this->push_back(elem);
+		if (this->size_ + 1 == this->capacity_)
+		{
+			// the arguments may refer to elements of this stack, so the element is made before _expand
+			Elem made__(std::forward<Args>(args)...);
+			this->_expand();
+			this->_data()[this->size_++] = std::move(made__);
+			return;
+		}
+		_construct_in_slot(this->_data() + this->size_, std::forward<Args>(args)...);
+		this->size_++;
 	}
 
 	template<typename Elem>
@@ -90,28 +185,429 @@ namespace tvj
 #ifndef NDEBUG
 		if (empty()) throw std::underflow_error("pop an empty stack");
 #endif
+		return std::move(this->_data()[--this->size_]);
+	}
 
-		auto ret = *this->cback();
-		this->size_--;
-		return ret;
+	template<typename Elem>
+	inline const Elem& stack<Elem>::peak() const
+	{
+#ifndef NDEBUG
+		if (empty()) throw std::underflow_error("peak an empty stack");
+#endif
+		return this->_data()[this->size_ - 1];
 	}
 
 	template<typename Elem>
-	inline const Elem& stack<Elem>::peak()
+	inline Elem& stack<Elem>::peak()
 	{
 #ifndef NDEBUG
 		if (empty()) throw std::underflow_error("peak an empty stack");
 #endif
-		return *this->cback();
+		return this->_data()[this->size_ - 1];
 	}
 
 	template<typename Elem>
-	inline const Elem& stack<Elem>::top()
+	inline const Elem& stack<Elem>::top() const
 	{
 #ifndef NDEBUG
 		if (empty()) throw std::underflow_error("top an empty stack");
 #endif
-		return *this->cback();
+		return this->_data()[this->size_ - 1];
+	}
+
+	template<typename Elem>
+	inline Elem& stack<Elem>::top()
+	{
+#ifndef NDEBUG
+		if (empty()) throw std::underflow_error("top an empty stack");
+#endif
+		return this->_data()[this->size_ - 1];
+	}
+
+	// a stack of at most N elements stored in place (no dynamic allocation),
+	// for traversals whose depth is bounded, e.g. N >= 2 * log2(size) for a balanced tree
+	template<typename Elem, size_t N>
+	class inline_stack
+	{
+	public:
+
+		/**
+		 * brief: size
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: the maximum number of elements
+		 * param: (void)
+		 * return: size_t
+		 */
+		static constexpr size_t capacity() noexcept { return N; }
+
+		/**
+		 * brief: check if it is empty
+		 * param: (void)
+		 * return: bool
+		 */
+		bool empty() const noexcept;
+
+		/**
+		 * brief: check if it is full
+		 * param: (void)
+		 * return: bool
+		 */
+		bool full() const noexcept;
+
+		/**
+		 * brief: push an element into stack (copied / moved in)
+		 * param: the element
+		 * return: void
+		 */
+		void push(const Elem& elem);
+		void push(Elem&& elem);
+
+		/**
+		 * brief: push an element constructed from the arguments
+		 * param: the arguments of the constructor
+		 * return: void
+		 */
+		template<typename... Args>
+		void emplace(Args&&... args);
+
+		/**
+		 * brief: pop an element from stack
+		 * param: (void)
+		 * return: the removed element (moved out)
+		 */
+		Elem pop();
+
+		/**
+		 * brief: peak the top element
+		 *        (this function is overloaded)
+		 * param: (void)
+		 * return: the top element
+		 */
+		const Elem& top() const;
+		Elem& top();
+
+		/**
+		 * brief: clear the stack
+		 * param: (void)
+		 * return: void
+		 */
+		void clear() noexcept;
+
+	private:
+		Elem data_[N];
+		size_t size_ = 0;
+	};
+
+	template<typename Elem, size_t N>
+	inline size_t inline_stack<Elem, N>::size() const noexcept
+	{
+		return size_;
+	}
+
+	template<typename Elem, size_t N>
+	inline bool inline_stack<Elem, N>::empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	template<typename Elem, size_t N>
+	inline bool inline_stack<Elem, N>::full() const noexcept
+	{
+		return size_ == N;
+	}
+
+	template<typename Elem, size_t N>
+	inline void inline_stack<Elem, N>::push(const Elem& elem)
+	{
+#ifndef NDEBUG
+		if (full()) throw std::overflow_error("push a full inline_stack");
+#endif
+		data_[size_++] = elem;
+	}
+
+	template<typename Elem, size_t N>
+	inline void inline_stack<Elem, N>::push(Elem&& elem)
+	{
+#ifndef NDEBUG
+		if (full()) throw std::overflow_error("push a full inline_stack");
+#endif
+		data_[size_++] = std::move(elem);
+	}
+
+	template<typename Elem, size_t N>
+	template<typename... Args>
+	inline void inline_stack<Elem, N>::emplace(Args&&... args)
+	{
+#ifndef NDEBUG
+		if (full()) throw std::overflow_error("push a full inline_stack");
+#endif
+		_construct_in_slot(data_ + size_, std::forward<Args>(args)...);
+		size_++;
+	}
+
+	template<typename Elem, size_t N>
+	inline Elem inline_stack<Elem, N>::pop()
+	{
+#ifndef NDEBUG
+		if (empty()) throw std::underflow_error("pop an empty inline_stack");
+#endif
+		return std::move(data_[--size_]);
+	}
+
+	template<typename Elem, size_t N>
+	inline const Elem& inline_stack<Elem, N>::top() const
+	{
+#ifndef NDEBUG
+		if (empty()) throw std::underflow_error("top an empty inline_stack");
+#endif
+		return data_[size_ - 1];
+	}
+
+	template<typename Elem, size_t N>
+	inline Elem& inline_stack<Elem, N>::top()
+	{
+#ifndef NDEBUG
+		if (empty()) throw std::underflow_error("top an empty inline_stack");
+#endif
+		return data_[size_ - 1];
+	}
+
+	template<typename Elem, size_t N>
+	inline void inline_stack<Elem, N>::clear() noexcept
+	{
+		size_ = 0;
+	}
+
+	// a stack of fixed-size blocks chained from the top down,
+	// so that growing never copies the elements and push and pop are O(1) in the worst case,
+	// the last block emptied is kept as a spare so that crossing a block boundary back and forth does not allocate
+	template<typename Elem>
+	class segmented_stack
+	{
+	public:
+
+		/**
+		 * brief: the number of elements in each block
+		 * param: (void)
+		 * return: size_t
+		 */
+		static constexpr size_t block_size() noexcept
+		{
+			return sizeof(_block::data_) / sizeof(Elem);
+		}
+
+		/**
+		 * brief: default constructor
+		 * param: (void)
+		 * return: --
+		 */
+		segmented_stack() noexcept = default;
+
+		segmented_stack(const segmented_stack&) = delete;
+		segmented_stack& operator=(const segmented_stack&) = delete;
+
+		/**
+		 * brief: destructor
+		 * param: (void)
+		 * return: --
+		 */
+		~segmented_stack();
+
+		/**
+		 * brief: size
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: check if it is empty
+		 * param: (void)
+		 * return: bool
+		 */
+		bool empty() const noexcept;
+
+		/**
+		 * brief: push an element into stack (copied / moved in)
+		 * param: the element
+		 * return: void
+		 */
+		void push(const Elem& elem);
+		void push(Elem&& elem);
+
+		/**
+		 * brief: push an element constructed from the arguments
+		 * param: the arguments of the constructor
+		 * return: void
+		 */
+		template<typename... Args>
+		void emplace(Args&&... args);
+
+		/**
+		 * brief: pop an element from stack
+		 * param: (void)
+		 * return: the removed element (moved out)
+		 */
+		Elem pop();
+
+		/**
+		 * brief: peak the top element
+		 *        (this function is overloaded)
+		 * param: (void)
+		 * return: the top element
+		 */
+		const Elem& top() const;
+		Elem& top();
+
+		/**
+		 * brief: clear the stack (the blocks other than the spare are freed)
+		 * param: (void)
+		 * return: void
+		 */
+		void clear() noexcept;
+
+	private:
+
+		struct _block
+		{
+			Elem data_[sizeof(Elem) < SEGMENTED_STACK_BLOCK_BYTES ? SEGMENTED_STACK_BLOCK_BYTES / sizeof(Elem) : 1];
+			_block* below_;
+		};
+
+		/**
+		 * brief: make room for one more element, starting a new block if the top one is full
+		 * param: (void)
+		 * return: where the element goes
+		 */
+		Elem* _slot();
+
+		// the top block, only its first used_ elements are in the stack
+		_block* top_ = nullptr;
+		size_t used_ = 0;
+
+		// an empty block kept for the next push across the boundary
+		_block* spare_ = nullptr;
+
+		size_t size_ = 0;
+	};
+
+	template<typename Elem>
+	inline segmented_stack<Elem>::~segmented_stack()
+	{
+		clear();
+		delete spare_;
+	}
+
+	template<typename Elem>
+	inline size_t segmented_stack<Elem>::size() const noexcept
+	{
+		return size_;
+	}
+
+	template<typename Elem>
+	inline bool segmented_stack<Elem>::empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	template<typename Elem>
+	inline void segmented_stack<Elem>::push(const Elem& elem)
+	{
+		*_slot() = elem;
+	}
+
+	template<typename Elem>
+	inline void segmented_stack<Elem>::push(Elem&& elem)
+	{
+		*_slot() = std::move(elem);
+	}
+
+	template<typename Elem>
+	template<typename... Args>
+	inline void segmented_stack<Elem>::emplace(Args&&... args)
+	{
+		Elem* slot__ = _slot();
+		try
+		{
+			_construct_in_slot(slot__, std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			used_--;
+			size_--;
+			throw;
+		}
+	}
+
+	template<typename Elem>
+	inline Elem segmented_stack<Elem>::pop()
+	{
+#ifndef NDEBUG
+		if (empty()) throw std::underflow_error("pop an empty segmented_stack");
+#endif
+		Elem ret = std::move(top_->data_[--used_]);
+		size_--;
+		if (used_ == 0 && top_->below_)
+		{
+			// keep the emptied block as the spare
+			delete spare_;
+			spare_ = top_;
+			top_ = top_->below_;
+			used_ = block_size();
+		}
+		return ret;
+	}
+
+	template<typename Elem>
+	inline const Elem& segmented_stack<Elem>::top() const
+	{
+#ifndef NDEBUG
+		if (empty()) throw std::underflow_error("top an empty segmented_stack");
+#endif
+		return top_->data_[used_ - 1];
+	}
+
+	template<typename Elem>
+	inline Elem& segmented_stack<Elem>::top()
+	{
+#ifndef NDEBUG
+		if (empty()) throw std::underflow_error("top an empty segmented_stack");
+#endif
+		return top_->data_[used_ - 1];
+	}
+
+	template<typename Elem>
+	inline void segmented_stack<Elem>::clear() noexcept
+	{
+		while (top_)
+		{
+			_block* below__ = top_->below_;
+			if (spare_) delete top_;
+			else spare_ = top_;
+			top_ = below__;
+		}
+		used_ = 0;
+		size_ = 0;
+	}
+
+	template<typename Elem>
+	inline Elem* segmented_stack<Elem>::_slot()
+	{
+		if (!top_ || used_ == block_size())
+		{
+			_block* block__ = spare_ ? spare_ : new _block;
+			spare_ = nullptr;
+			block__->below_ = top_;
+			top_ = block__;
+			used_ = 0;
+		}
+		size_++;
+		return top_->data_ + used_++;
 	}
 }
 
@@ -5,8 +5,43 @@
  * @author: Teddy van Jerry
  * @licence: The MIT Licence
  * @compiler: at least C++/11 (tested on MSVC and MinGW)
- * @reliance: TVJ_Vector.h version 1.2
+ * @reliance: TVJ_Vector.h version 1.6, TVJ_String_Search.h version 1.1, TVJ_UTF8.h version 1.0
  *
+ * @version 1.9 2026/10/18
+ * - operator + builds a lazy string_concat, allocated once when assigned or converted to string
+ * - operator + also takes a C-style string or a char on the left
+ * 
+ * @version 1.8 2026/10/18
+ * - add function find_all
+ * 
+ * @version 1.7 2026/10/18
+ * - add UTF-8 validation, code point counting, iteration and transcoding to and from UTF-32
+ * 
+ * @version 1.6 2026/10/18
+ * - operator== and operator!= compare the whole buffer at once
+ * - operator<< writes the whole buffer at once
+ * 
+ * @version 1.5 2026/10/18
+ * - operator>> reads tokens of any length directly into the string
+ * - remove STRING_MAX_SIZE
+ * 
+ * @version 1.4 2026/10/18
+ * - function c_str returns the internal buffer instead of a new copy
+ * - add function data
+ * - the last '\0' is always maintained (constructors, clear and remove_at)
+ * 
+ * @version 1.3 2026/10/18
+ * - function append writes at the tail directly (amortized constant per char)
+ * - add function reserve and append with a char array
+ * - copy and operator= copy the whole buffer at once
+ * - bug fix: insert_after with index -1 (i.e. at the beginning)
+ * - bug fix: insert_after a char
+ * 
+ * @version 1.2 2026/10/18
+ * - replace the KMP in function find with the search engine in TVJ_String_Search.h
+ * - add find, contains and count with a precompiled searcher
+ * - bug fix in function count
+ * 
  * @version 1.1 2021/05/14
  * - add function c_str
  * 
@@ -17,7 +52,11 @@
 
 #pragma once
 #include <iostream>
+#include <cstring>
+#include <cctype>
 #include "TVJ_Vector.h"
+#include "TVJ_String_Search.h"
+#include "TVJ_UTF8.h"
 
 namespace tvj
 {
@@ -70,23 +109,117 @@ namespace tvj
 		}
 	}
 
+	// a piece of a concatenation: chars referred to without copying
+	struct _string_piece
+	{
+		const char* data_;
+		size_t size_;
+
+		size_t size() const noexcept { return size_; }
+		char* write(char* out) const noexcept
+		{
+			memcpy(out, data_, size_);
+			return out + size_;
+		}
+		bool overlaps(const char* begin, const char* end) const noexcept { return data_ < end && data_ + size_ > begin; }
+	};
+
+	// a piece of a concatenation: a single char
+	struct _char_piece
+	{
+		char ch_;
+
+		size_t size() const noexcept { return 1; }
+		char* write(char* out) const noexcept
+		{
+			*out = ch_;
+			return out + 1;
+		}
+		bool overlaps(const char*, const char*) const noexcept { return false; }
+	};
+
+	// a lazy concatenation built by operator +,
+	// the total length is known before anything is copied,
+	// so that the result is allocated once and each piece is copied once
+	// (it refers to its operands, so it should be used within the same full expression)
+	template<typename Left, typename Right>
+	class string_concat
+	{
+	public:
+
+		/**
+		 * brief: constructor
+		 * param: the left and the right part
+		 * return: --
+		 */
+		string_concat(const Left& left, const Right& right) noexcept : left_(left), right_(right) { }
+
+		/**
+		 * brief: the length of the result
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept { return left_.size() + right_.size(); }
+
+		/**
+		 * brief: copy the result to a buffer
+		 * param: the buffer (with room for size() chars)
+		 * return: one past the last char written
+		 */
+		char* write(char* out) const noexcept { return right_.write(left_.write(out)); }
+
+		/**
+		 * brief: check if any piece refers to a range of chars
+		 * param: the begin and end of the range
+		 * return: bool
+		 */
+		bool overlaps(const char* begin, const char* end) const noexcept { return left_.overlaps(begin, end) || right_.overlaps(begin, end); }
+
+	private:
+		Left left_;
+		Right right_;
+	};
+
 	// a string class that offers safer and easier use
 	class string : protected vector<char>
 	{
 		// @ friendship declaration
 		friend inline std::istream& operator>>(std::istream& in, string& str);
+		friend class string_builder;
+		friend struct _string_io;
 
 	public:
 
-#define STRING_MAX_SIZE 32768 // the buff size when using std::istream
-
 		// @ constructors
-		using vector::vector;
 		string();
+
+		/**
+		 * brief: constructor
+		 * param: size, the char to fill and capacity
+		 * return: --
+		 */
+		string(size_t size, const char& ch, size_t capacity = 32);
+
+		/**
+		 * brief: constructor from iterators (or a range of char pointers)
+		 * param: the begin and end iterator
+		 * return: --
+		 */
+		template<typename _Iter>
+		string(const _Iter& iter1, const _Iter& iter2);
+
 		string(const char* str);
 		string(const char& ch);
 		string(const string& str);
 
+		/**
+		 * brief: constructor from a concatenation (allocate once)
+		 * param: the concatenation
+		 * return: --
+		 */
+		template<typename Left, typename Right>
+		string(const string_concat<Left, Right>& expr);
+
 		// @ iterator using declaration (inherited from vector<char>)
 		using vector::const_iterator;
 		using vector::iterator;
@@ -141,6 +274,20 @@ namespace tvj
 		 */
 		string& append(const string& str) noexcept;
 
+		/**
+		 * brief: append a char array at the end of the string
+		 * param: the char array and its length
+		 * return: string (read & write)
+		 */
+		string& append(const char* str, size_t length) noexcept;
+
+		/**
+		 * brief: reserve space so that appending up to a certain size does not reallocate
+		 * param: the expected size (not including the last '\0')
+		 * return: void
+		 */
+		void reserve(size_t size);
+
 		/**
 		 * brief: find substring after a certain position (default as 0),
 		 *        return the index, one past of the last indicating cannot find
@@ -149,6 +296,14 @@ namespace tvj
 		 */
 		size_t find(const string& str, size_t pos = 0) const noexcept;
 
+		/**
+		 * brief: find the precompiled pattern after a certain position (default as 0),
+		 *        return the index, one past of the last indicating cannot find
+		 * param: searcher and the starting position
+		 * return: size_t
+		 */
+		size_t find(const searcher& pattern, size_t pos = 0) const noexcept;
+
 		/**
 		 * brief: check if it has a substring
 		 * param: string
@@ -157,12 +312,77 @@ namespace tvj
 		bool contains(const string& str) const noexcept;
 
 		/**
-		 * brief: count the number of substring it has
+		 * brief: check if it has the precompiled pattern
+		 * param: searcher
+		 * return: bool
+		 */
+		bool contains(const searcher& pattern) const noexcept;
+
+		/**
+		 * brief: count the number of substring it has (overlapping ones included)
 		 * param: string
 		 * return: size_t
 		 */
 		size_t count(const string& str) const noexcept;
 
+		/**
+		 * brief: count the number of the precompiled pattern it has (overlapping ones included)
+		 * param: searcher
+		 * return: size_t
+		 */
+		size_t count(const searcher& pattern) const noexcept;
+
+		/**
+		 * brief: the indices of all occurrences of a substring (overlapping ones included),
+		 *        found in one pass
+		 * param: string
+		 * return: vector<size_t>
+		 */
+		vector<size_t> find_all(const string& str) const;
+
+		/**
+		 * brief: the indices of all occurrences of the precompiled pattern (overlapping ones included),
+		 *        found in one pass
+		 * param: searcher
+		 * return: vector<size_t>
+		 */
+		vector<size_t> find_all(const searcher& pattern) const;
+
+		/**
+		 * brief: check if the string is well-formed UTF-8
+		 * param: void
+		 * return: bool
+		 */
+		bool valid_utf8() const noexcept;
+
+		/**
+		 * brief: the number of UTF-8 code points (the string is expected to be well-formed)
+		 * param: void
+		 * return: size_t
+		 */
+		size_t utf8_length() const noexcept;
+
+		/**
+		 * brief: iterate the UTF-8 code points (invalidated when the string is changed)
+		 * param: void
+		 * return: utf8_view
+		 */
+		utf8_view code_points() const noexcept;
+
+		/**
+		 * brief: transcode to UTF-32, malformed sequences give TVJ_UTF8_REPLACEMENT
+		 * param: void
+		 * return: vector<char32_t>
+		 */
+		vector<char32_t> to_utf32() const;
+
+		/**
+		 * brief: transcode from UTF-32, invalid code points give TVJ_UTF8_REPLACEMENT
+		 * param: the code points and the number of them
+		 * return: string
+		 */
+		static string from_utf32(const char32_t* str, size_t length);
+
 		/**
 		 * brief: remove at the certain index and return it
 		 * param: size_t index
@@ -184,29 +404,29 @@ namespace tvj
 		//string right(size_t number);
 
 		/**
-		 * brief: return the c-style string
+		 * brief: return the c-style string (the internal buffer, no copy),
+		 *        valid until the string is changed
 		 * param: void
-		 * return: char*
+		 * return: const char*
 		 */
-		char* c_str() const noexcept;
-		
-	protected:
+		const char* c_str() const noexcept;
 
 		/**
-		 * brief: define next used in function find (KPM method)
-		 * param: the substring and array next
-		 * return: void
+		 * brief: return the internal buffer (size() chars followed by '\0'),
+		 *        valid until the string is changed
+		 *        (this function is overloaded)
+		 * param: void
+		 * return: const char* / char*
 		 */
-		void _get_next(const string& P, int* next) const noexcept;
-
-	public:
+		const char* data() const noexcept;
+		char* data() noexcept;
 
 		/**
 		 * brief: clear the string
 		 * param: void
 		 * return: void
 		 */
-		using vector::clear;
+		void clear() noexcept;
 
 		/**
 		 * brief: check if the string is empty
@@ -239,18 +459,20 @@ namespace tvj
 		string& operator=(const string& str);
 
 		/**
-		 * brief: operator +, append string at the end, do not change this
-		 * param: another string
-		 * return: the copy of appended string
+		 * brief: copy the result of a concatenation (allocate at most once)
+		 * param: the concatenation
+		 * return: the copied string (read & write)
 		 */
-		string operator+(const string& str) const noexcept;
+		template<typename Left, typename Right>
+		string& operator=(const string_concat<Left, Right>& expr);
 
 		/**
-		 * brief: operator +, append char at the end, do not change this
-		 * param: char
-		 * return: the copy of appended string
+		 * brief: operator +, append the result of a concatenation (change this)
+		 * param: the concatenation
+		 * return: the copy of string (*this) (read & write)
 		 */
-		string operator+(const char& ch) const noexcept;
+		template<typename Left, typename Right>
+		string& operator+=(const string_concat<Left, Right>& expr);
 
 		/**
 		 * brief: operator +, append string at the end (change this)
@@ -267,8 +489,8 @@ namespace tvj
 		string& operator+=(const char& ch) noexcept;
 
 		// @ relationship operators
-		using vector::operator==;
-		using vector::operator!=;
+		bool operator==(const string& str) const noexcept;
+		bool operator!=(const string& str) const noexcept;
 		bool operator<(const string& str) const noexcept;
 		bool operator>(const string& str) const noexcept;
 		bool operator<=(const string& str) const noexcept;
@@ -276,6 +498,15 @@ namespace tvj
 
 	private:
 
+		/**
+		 * brief: write a concatenation after the first chars kept,
+		 *        in place if it fits and does not refer to this, otherwise into a new buffer
+		 * param: the concatenation and the number of chars kept
+		 * return: void
+		 */
+		template<typename Expr>
+		void _write_concat(const Expr& expr, size_t keep);
+
 		/**
 		 * brief: change one past the last char to 0 to make 'vec' look like a real string
 		 * param: void
@@ -289,6 +520,25 @@ namespace tvj
 		_set_string_end_zero();
 	}
 
+	inline string::string(size_t size, const char& ch, size_t capacity) : vector(size, ch, capacity)
+	{
+		_set_string_end_zero();
+	}
+
+	template<typename _Iter>
+	inline string::string(const _Iter& iter1, const _Iter& iter2)
+	{
+#ifndef NDEBUG
+		if (iter2 - iter1 < 0) error_info("The order of iterators is illegal of tvj::string constructor.", TVJ_STRING_ITER_RANGE);
+#endif
+		this->reserve(static_cast<size_t>(iter2 - iter1));
+		for (auto i = iter1; i != iter2; i++)
+		{
+			this->push_back(*i);
+		}
+		_set_string_end_zero();
+	}
+
 	inline string::string(const char* str)
 	{
 		while (str && *str != 0)
@@ -306,11 +556,7 @@ namespace tvj
 
 	inline string::string(const string& str)
 	{
-		for (int i = 0; i != str.size_; i++)
-		{
-			this->push_back(str[i]);
-		}
-		_set_string_end_zero();
+		this->append(str._data(), str.size_);
 	}
 
 	inline size_t string::length() const noexcept
@@ -320,32 +566,24 @@ namespace tvj
 
 	inline string& string::insert_after(long long index, const char& ch)
 	{
-#ifndef NDEBUG
-		if(index >= this->size_) error_info("Overflow in insert_after of tvj::string", TVJ_STRING_OVERFLOW);
-		// no underflow
-		// as they are regarded as insert before the first char
-#endif
-		vector<char>::insert_after(index, ch);
+		return this->insert_after(index, string(ch));
 	}
 
 	inline string& string::insert_after(long long index, const string& str)
 	{
 #ifndef NDEBUG
-		if (index >= this->size_) error_info("Overflow in insert_after of tvj::string", TVJ_STRING_OVERFLOW);
+		if (index >= static_cast<long long>(this->size_)) error_info("Overflow in insert_after of tvj::string", TVJ_STRING_OVERFLOW);
 		// no underflow
 		// as they are regarded as insert before the first char
 #endif
 		if (index < -1) index = -1; // negative number defined as at the beginning
-		while (this->size_ + str.size_ + 1 > this->capacity_)
-		{
-			this->_expand();
-		}
-		this->_move(index + 1, str.size_);
-		this->size_ += str.size_;
-		for (auto i = index + 1; i != index + str.size_ + 1; i++)
-		{
-			(*this)[i] = str[i - index - 1];
-		}
+		if (index == static_cast<long long>(this->size_) - 1) return this->append(str);
+		const string copy__ = &str == this ? str : string(); // inserting itself
+		const string& src__ = &str == this ? copy__ : str;
+		this->_reserve(this->size_ + src__.size_ + 1);
+		this->_move(static_cast<size_t>(index + 1), static_cast<long long>(src__.size_));
+		memcpy(this->_data() + index + 1, src__._data(), src__.size_);
+		this->size_ += src__.size_;
 		_set_string_end_zero();
 		return *this;
 	}
@@ -359,27 +597,39 @@ namespace tvj
 
 	inline string& string::append(const string& str) noexcept
 	{
-		this->insert_after(static_cast<long long>(this->size_) - 1, str);
-		return *this;
+		return this->append(str._data(), str.size_);
 	}
 
-	inline size_t string::find(const string& str, size_t pos) const noexcept
+	inline string& string::append(const char* str, size_t length) noexcept
 	{
-		int* next = new int[str.size_];
-		long long i = pos;
-		long long j = 0;
-		_get_next(str, next);
-		while (i < static_cast<int>(this->size_) && j < static_cast<int>(str.size_))
+		if (this->size_ + length + 1 > this->capacity_)
 		{
-			if (j == -1 || (*this)[i] == str[j])
-			{
-				i++;
-				j++;
-			}
-			else j = next[j];
+			// appending part of itself
+			const bool inside__ = str >= this->_data() && str < this->_data() + this->capacity_;
+			const size_t offset__ = inside__ ? static_cast<size_t>(str - this->_data()) : 0;
+			this->_reserve(this->size_ + length + 1);
+			if (inside__) str = this->_data() + offset__;
 		}
-		if (j + 1 > str.size_) return i - str.size_;
-		else return this->size_;
+		memmove(this->_data() + this->size_, str, length);
+		this->size_ += length;
+		_set_string_end_zero();
+		return *this;
+	}
+
+	inline void string::reserve(size_t size)
+	{
+		this->_reserve(size + 1);
+		_set_string_end_zero(); // not copied by the reallocation
+	}
+
+	inline size_t string::find(const string& str, size_t pos) const noexcept
+	{
+		return _search(this->_data(), this->size_, str._data(), str.size_, pos);
+	}
+
+	inline size_t string::find(const searcher& pattern, size_t pos) const noexcept
+	{
+		return pattern.find(this->_data(), this->size_, pos);
 	}
 
 	inline bool string::contains(const string& str) const noexcept
@@ -388,16 +638,73 @@ namespace tvj
 		else return true;
 	}
 
+	inline bool string::contains(const searcher& pattern) const noexcept
+	{
+		return this->find(pattern) != this->size_;
+	}
+
 	inline size_t string::count(const string& str) const noexcept
 	{
-		if (this->size_ == 0) return 0;
-		size_t count_ = 0, location_ = 0;
-		while (location_ < this->size_)
+		// compile once instead of preparing the pattern on every find
+		return searcher(str._data(), str.size_).count(this->_data(), this->size_);
+	}
+
+	inline size_t string::count(const searcher& pattern) const noexcept
+	{
+		return pattern.count(this->_data(), this->size_);
+	}
+
+	inline vector<size_t> string::find_all(const string& str) const
+	{
+		return this->find_all(searcher(str._data(), str.size_));
+	}
+
+	inline vector<size_t> string::find_all(const searcher& pattern) const
+	{
+		vector<size_t> ret;
+		pattern.for_each(this->_data(), this->size_, [&ret](size_t index) { ret.push_back(index); });
+		return ret;
+	}
+
+	inline bool string::valid_utf8() const noexcept
+	{
+		return utf8_validate(this->_data(), this->size_);
+	}
+
+	inline size_t string::utf8_length() const noexcept
+	{
+		return utf8_count(this->_data(), this->size_);
+	}
+
+	inline utf8_view string::code_points() const noexcept
+	{
+		return utf8_view(this->_data(), this->size_);
+	}
+
+	inline vector<char32_t> string::to_utf32() const
+	{
+		size_t count__ = 0;
+		if (this->valid_utf8()) count__ = this->utf8_length();
+		else
 		{
-			location_ = 1 + find(str, location_);
-			count_++;
+			// each malformed byte becomes one replacement code point
+			for (size_t pos__ = 0; pos__ != this->size_; count__++) utf8_decode(this->_data(), this->size_, pos__);
 		}
-		return count_ - 1;
+		vector<char32_t> ret(count__, 0, count__ + 1);
+		if (count__) utf8_to_utf32(this->_data(), this->size_, &ret[0]);
+		return ret;
+	}
+
+	inline string string::from_utf32(const char32_t* str, size_t length)
+	{
+		string ret;
+		ret.reserve(length);
+		char buffer__[4];
+		for (size_t i = 0; i != length; i++)
+		{
+			ret.append(buffer__, utf8_encode(str[i], buffer__));
+		}
+		return ret;
 	}
 
 	inline char string::remove_at(size_t index)
@@ -406,7 +713,9 @@ namespace tvj
 		if (index >= this->size_) error_info("Overflow in remove_at of tvj::string", TVJ_STRING_OVERFLOW);
 		if (index < 0)            error_info("Underflow in remove_at of tvj::string", TVJ_STRING_UNDERFLOW);
 #endif
-		return vector<char>::remove_at(index);
+		const char ret = vector<char>::remove_at(index);
+		_set_string_end_zero();
+		return ret;
 	}
 
 	inline void string::remove_at(size_t index_begin, size_t index_end)
@@ -417,67 +726,77 @@ namespace tvj
 		// no underflow check for index_begin as it is unsigner (size_t)
 #endif
 		vector<char>::_move(index_end, static_cast<long long>(index_begin) - static_cast<long long>(index_end));
-		_set_string_end_zero();
 		size_ = size_ + index_begin - index_end;
+		_set_string_end_zero();
 	}
 
-	inline char* string::c_str() const noexcept
+	inline const char* string::c_str() const noexcept
 	{
-		char* str__ = new char[this->size_ + 1];
-		for (size_t i = 0; i != this->size_; i++)
-		{
-			str__[i] = (*this)[i];
-		}
-		str__[this->size_] = 0;
-		return str__;
+		return this->_data();
 	}
 
-	inline void string::_get_next(const string& P, int* next) const noexcept
+	inline const char* string::data() const noexcept
 	{
-		long long j = 0;
-		next[0] = -1;
-		long long k = -1;
-		while (j < P.size_)
-		{
-			if (k == -1 || P[j] == P[k])
-			{
-				k++;
-				j++;
-				next[j] = k;
-			}
-			else
-			{
-				k = next[k];
-			}
-		}
+		return this->_data();
+	}
+
+	inline char* string::data() noexcept
+	{
+		return this->_data();
+	}
+
+	inline void string::clear() noexcept
+	{
+		this->size_ = 0;
+		_set_string_end_zero();
 	}
 
 	inline string& string::operator=(const string& str)
 	{
-		for (int i = 0; i != this->size_ && i != str.size_; i++)
-		{
-			(*this)[i] = str[i];
-		}
-		for (int i = this->size_; i < str.size_; i++)
-		{
-			this->push_back(str[i]);
-		}
-		this->size_ = str.size_;
+		if (&str == this) return *this;
+		this->size_ = 0;
+		return this->append(str._data(), str.size_);
+	}
+
+	template<typename Left, typename Right>
+	inline string::string(const string_concat<Left, Right>& expr)
+	{
+		_write_concat(expr, 0);
+	}
+
+	template<typename Left, typename Right>
+	inline string& string::operator=(const string_concat<Left, Right>& expr)
+	{
+		_write_concat(expr, 0);
 		return *this;
 	}
 
-	inline string string::operator+(const string& str) const noexcept
+	template<typename Left, typename Right>
+	inline string& string::operator+=(const string_concat<Left, Right>& expr)
 	{
-		string ret = *this;
-		ret.append(str);
-		return ret;
+		_write_concat(expr, this->size_);
+		return *this;
 	}
 
-	inline string string::operator+(const char& ch) const noexcept
+	template<typename Expr>
+	inline void string::_write_concat(const Expr& expr, size_t keep)
 	{
-		string ret = *this;
-		ret.append(ch);
-		return ret;
+		const size_t size__ = keep + expr.size();
+		if (size__ + 1 <= this->capacity_ && !expr.overlaps(this->_data(), this->_data() + this->capacity_))
+		{
+			expr.write(this->_data() + keep);
+		}
+		else
+		{
+			size_t capacity__ = this->capacity_ < 2 ? 2 : this->capacity_;
+			while (capacity__ < size__ + 1) capacity__ <<= 1;
+			char* buffer__ = new char[capacity__];
+			memcpy(buffer__, this->_data(), keep);
+			expr.write(buffer__ + keep); // the old buffer is still alive if the pieces refer to it
+			this->_adopt(buffer__, size__, capacity__);
+		}
+		this->size_ = size__;
+		_set_string_end_zero();
 	}
 
 	inline string& string::operator+=(const string& str) noexcept
@@ -492,6 +811,98 @@ namespace tvj
 		return *this;
 	}
 
+	/**
+	 * brief: the piece of a string in a concatenation
+	 * param: the string / C-style string / char
+	 * return: _string_piece / _char_piece
+	 */
+	inline _string_piece _concat_piece(const string& str) noexcept
+	{
+		return _string_piece{ str.data(), str.size() };
+	}
+
+	inline _string_piece _concat_piece(const char* str) noexcept
+	{
+		return _string_piece{ str ? str : "", str ? strlen(str) : 0 };
+	}
+
+	inline _char_piece _concat_piece(char ch) noexcept
+	{
+		return _char_piece{ ch };
+	}
+
+	/**
+	 * brief: operator +, the lazy concatenation of strings, C-style strings and chars,
+	 *        nothing is copied until it is assigned or converted to string
+	 * param: the two operands (at least one of them a string or a concatenation)
+	 * return: string_concat
+	 */
+	inline string_concat<_string_piece, _string_piece> operator+(const string& left, const string& right) noexcept
+	{
+		return string_concat<_string_piece, _string_piece>(_concat_piece(left), _concat_piece(right));
+	}
+
+	inline string_concat<_string_piece, _string_piece> operator+(const string& left, const char* right) noexcept
+	{
+		return string_concat<_string_piece, _string_piece>(_concat_piece(left), _concat_piece(right));
+	}
+
+	inline string_concat<_string_piece, _string_piece> operator+(const char* left, const string& right) noexcept
+	{
+		return string_concat<_string_piece, _string_piece>(_concat_piece(left), _concat_piece(right));
+	}
+
+	inline string_concat<_string_piece, _char_piece> operator+(const string& left, char right) noexcept
+	{
+		return string_concat<_string_piece, _char_piece>(_concat_piece(left), _concat_piece(right));
+	}
+
+	inline string_concat<_char_piece, _string_piece> operator+(char left, const string& right) noexcept
+	{
+		return string_concat<_char_piece, _string_piece>(_concat_piece(left), _concat_piece(right));
+	}
+
+	template<typename Left, typename Right>
+	inline string_concat<string_concat<Left, Right>, _string_piece> operator+(const string_concat<Left, Right>& left, const string& right) noexcept
+	{
+		return string_concat<string_concat<Left, Right>, _string_piece>(left, _concat_piece(right));
+	}
+
+	template<typename Left, typename Right>
+	inline string_concat<string_concat<Left, Right>, _string_piece> operator+(const string_concat<Left, Right>& left, const char* right) noexcept
+	{
+		return string_concat<string_concat<Left, Right>, _string_piece>(left, _concat_piece(right));
+	}
+
+	template<typename Left, typename Right>
+	inline string_concat<string_concat<Left, Right>, _char_piece> operator+(const string_concat<Left, Right>& left, char right) noexcept
+	{
+		return string_concat<string_concat<Left, Right>, _char_piece>(left, _concat_piece(right));
+	}
+
+	template<typename Left, typename Right>
+	inline string_concat<_string_piece, string_concat<Left, Right>> operator+(const string& left, const string_concat<Left, Right>& right) noexcept
+	{
+		return string_concat<_string_piece, string_concat<Left, Right>>(_concat_piece(left), right);
+	}
+
+	template<typename Left1, typename Right1, typename Left2, typename Right2>
+	inline string_concat<string_concat<Left1, Right1>, string_concat<Left2, Right2>> operator+(
+		const string_concat<Left1, Right1>& left, const string_concat<Left2, Right2>& right) noexcept
+	{
+		return string_concat<string_concat<Left1, Right1>, string_concat<Left2, Right2>>(left, right);
+	}
+
+	inline bool string::operator==(const string& str) const noexcept
+	{
+		return this->size_ == str.size_ && memcmp(this->_data(), str._data(), this->size_) == 0;
+	}
+
+	inline bool string::operator!=(const string& str) const noexcept
+	{
+		return !(*this == str);
+	}
+
 	inline bool string::operator<(const string& str) const noexcept
 	{
 		for (size_t i = 0; i != this->size_ && i != str.size_; i++)
@@ -534,42 +945,54 @@ namespace tvj
 
 	inline void string::_set_string_end_zero() noexcept
 	{
-#ifndef NDEBUG
-#define NDEBUG // disable subscript range check
-		(*this)[this->size_] = 0;
-#undef  NDEBUG
-#else
-		(*this)[this->size_] = 0;
-#endif
+		this->_data()[this->size_] = 0; // capacity_ is always larger than size_
 	}
 
 	inline std::istream& operator>>(std::istream& in, string& str)
 	{
-		//char ch = 0;
-		//str.clear();
-		//in >> ch;
-		//while (ch != EOF && !isspace(ch))
-		//{
-		//	str.append(ch);
-		//	in >> ch;
-		//}
-		//str._set_string_end_zero();
-		char* buff = new char[STRING_MAX_SIZE];
-		in.width(STRING_MAX_SIZE); // set the width to avoid overflow
-		in >> buff;
-		str = buff;
-		delete[] buff;
+		str.clear();
+		std::istream::sentry sentry__(in); // skip the leading whitespace
+		if (!sentry__) return in;
+		size_t limit__ = in.width() > 0 ? static_cast<size_t>(in.width()) : static_cast<size_t>(-1);
+		std::streambuf* buf__ = in.rdbuf();
+		int ch = buf__->sgetc();
+		while (str.size_ != limit__ && ch != std::char_traits<char>::eof() && !isspace(ch))
+		{
+			str.append(static_cast<char>(ch));
+			ch = buf__->snextc();
+		}
+		in.width(0);
+		if (ch == std::char_traits<char>::eof()) in.setstate(std::ios_base::eofbit);
+		if (str.empty()) in.setstate(std::ios_base::failbit);
 		return in;
 	}
 
 	inline std::ostream& operator<<(std::ostream& out, const string& str)
 	{
-		for (size_t i = 0; i != str.size(); i++)
-		{
-			out << str[i];
-		}
+		out.write(str.data(), static_cast<std::streamsize>(str.size()));
 		return out;
 	}
+
+	template<typename Left, typename Right>
+	inline std::ostream& operator<<(std::ostream& out, const string_concat<Left, Right>& expr)
+	{
+		return out << string(expr);
+	}
+
+	inline searcher::searcher(const string& pattern)
+	{
+		_compile(&pattern[0], pattern.size());
+	}
+
+	inline size_t searcher::find(const string& text, size_t pos) const noexcept
+	{
+		return text.find(*this, pos);
+	}
+
+	inline size_t searcher::count(const string& text) const noexcept
+	{
+		return text.count(*this);
+	}
 }
 
 // ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
\ No newline at end of file
@@ -0,0 +1,315 @@
+/*
+ * File: TVJ_String_Builder.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_String.h 1.3
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstring>
+#include "TVJ_String.h"
+
+namespace tvj
+{
+	// assemble a long string by appending pieces,
+	// the result is handed over to a string by function take without copying
+	class string_builder
+	{
+	public:
+
+#define STRING_BUILDER_CHUNK_SIZE 4096 // the buffer grows in whole chunks once it is this large
+
+		/**
+		 * brief: default constructor
+		 * param: (void)
+		 * return: --
+		 */
+		string_builder() noexcept;
+
+		/**
+		 * brief: constructor with the expected size
+		 * param: the expected size
+		 * return: --
+		 */
+		explicit string_builder(size_t size);
+
+		/**
+		 * brief: copy constructor
+		 * param: another string_builder
+		 * return: --
+		 */
+		string_builder(const string_builder& builder);
+
+		/**
+		 * brief: destructor
+		 * param: (void)
+		 * return: --
+		 */
+		~string_builder();
+
+		/**
+		 * brief: copy
+		 * param: another string_builder
+		 * return: string_builder (read & write)
+		 */
+		string_builder& operator=(const string_builder& builder);
+
+		/**
+		 * brief: reserve space so that appending up to a certain size does not reallocate
+		 * param: the expected size
+		 * return: void
+		 */
+		void reserve(size_t size);
+
+		/**
+		 * brief: append a char array
+		 * param: the char array and its length
+		 * return: string_builder (read & write)
+		 */
+		string_builder& append(const char* str, size_t length);
+
+		/**
+		 * brief: append a C-style string
+		 * param: the C-style string
+		 * return: string_builder (read & write)
+		 */
+		string_builder& append(const char* str);
+
+		/**
+		 * brief: append a string
+		 * param: the string
+		 * return: string_builder (read & write)
+		 */
+		string_builder& append(const string& str);
+
+		/**
+		 * brief: append a char
+		 * param: the char
+		 * return: string_builder (read & write)
+		 */
+		string_builder& append(const char& ch);
+
+		/**
+		 * brief: append the same char several times
+		 * param: the number of times and the char
+		 * return: string_builder (read & write)
+		 */
+		string_builder& append(size_t count, const char& ch);
+
+		/**
+		 * brief: operator <<, the same as function append
+		 * param: the string
+		 * return: string_builder (read & write)
+		 */
+		string_builder& operator<<(const string& str);
+
+		/**
+		 * brief: operator <<, the same as function append
+		 * param: the C-style string
+		 * return: string_builder (read & write)
+		 */
+		string_builder& operator<<(const char* str);
+
+		/**
+		 * brief: operator <<, the same as function append
+		 * param: the char
+		 * return: string_builder (read & write)
+		 */
+		string_builder& operator<<(const char& ch);
+
+		/**
+		 * brief: the number of chars appended so far
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: the number of chars that can be held without reallocation
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t capacity() const noexcept;
+
+		/**
+		 * brief: check if nothing is appended
+		 * param: (void)
+		 * return: bool
+		 */
+		bool empty() const noexcept;
+
+		/**
+		 * brief: drop the contents but keep the buffer
+		 * param: (void)
+		 * return: void
+		 */
+		void clear() noexcept;
+
+		/**
+		 * brief: hand the buffer over to a string without copying,
+		 *        the builder is empty afterwards
+		 * param: (void)
+		 * return: string
+		 */
+		string take();
+
+	private:
+
+		/**
+		 * brief: make room for a certain number of chars plus the last '\0'
+		 * param: the number of chars
+		 * return: void
+		 */
+		void _grow(size_t size);
+
+		// the buffer allocated by new[], nullptr before the first append
+		char* buffer_ = nullptr;
+
+		// the number of valid chars
+		size_t size_ = 0;
+
+		// the size of buffer_, always larger than size_ once allocated
+		size_t capacity_ = 0;
+	};
+
+	inline string_builder::string_builder() noexcept {}
+
+	inline string_builder::string_builder(size_t size)
+	{
+		reserve(size);
+	}
+
+	inline string_builder::string_builder(const string_builder& builder)
+	{
+		append(builder.buffer_, builder.size_);
+	}
+
+	inline string_builder::~string_builder()
+	{
+		if (buffer_) delete[] buffer_;
+		buffer_ = nullptr;
+	}
+
+	inline string_builder& string_builder::operator=(const string_builder& builder)
+	{
+		if (&builder == this) return *this;
+		size_ = 0;
+		return append(builder.buffer_, builder.size_);
+	}
+
+	inline void string_builder::reserve(size_t size)
+	{
+		if (size + 1 > capacity_) _grow(size);
+	}
+
+	inline string_builder& string_builder::append(const char* str, size_t length)
+	{
+		if (!length) return *this;
+		if (size_ + length + 1 > capacity_) _grow(size_ + length);
+		memcpy(buffer_ + size_, str, length);
+		size_ += length;
+		return *this;
+	}
+
+	inline string_builder& string_builder::append(const char* str)
+	{
+		return str ? append(str, strlen(str)) : *this;
+	}
+
+	inline string_builder& string_builder::append(const string& str)
+	{
+		return append(str._data(), str.size_);
+	}
+
+	inline string_builder& string_builder::append(const char& ch)
+	{
+		if (size_ + 2 > capacity_) _grow(size_ + 1);
+		buffer_[size_++] = ch;
+		return *this;
+	}
+
+	inline string_builder& string_builder::append(size_t count, const char& ch)
+	{
+		if (!count) return *this;
+		if (size_ + count + 1 > capacity_) _grow(size_ + count);
+		memset(buffer_ + size_, ch, count);
+		size_ += count;
+		return *this;
+	}
+
+	inline string_builder& string_builder::operator<<(const string& str)
+	{
+		return append(str);
+	}
+
+	inline string_builder& string_builder::operator<<(const char* str)
+	{
+		return append(str);
+	}
+
+	inline string_builder& string_builder::operator<<(const char& ch)
+	{
+		return append(ch);
+	}
+
+	inline size_t string_builder::size() const noexcept
+	{
+		return size_;
+	}
+
+	inline size_t string_builder::capacity() const noexcept
+	{
+		return capacity_ ? capacity_ - 1 : 0;
+	}
+
+	inline bool string_builder::empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	inline void string_builder::clear() noexcept
+	{
+		size_ = 0;
+	}
+
+	inline string string_builder::take()
+	{
+		string ret;
+		if (!buffer_) return ret;
+		buffer_[size_] = 0;
+		ret._adopt(buffer_, size_, capacity_);
+		buffer_ = nullptr;
+		size_ = 0;
+		capacity_ = 0;
+		return ret;
+	}
+
+	inline void string_builder::_grow(size_t size)
+	{
+		// double while small, then grow in whole chunks (at least doubling)
+		size_t new_capacity__ = capacity_ < 16 ? 16 : capacity_ << 1;
+		if (new_capacity__ < size + 1) new_capacity__ = size + 1;
+		if (new_capacity__ > STRING_BUILDER_CHUNK_SIZE)
+		{
+			new_capacity__ = (new_capacity__ + STRING_BUILDER_CHUNK_SIZE - 1) / STRING_BUILDER_CHUNK_SIZE * STRING_BUILDER_CHUNK_SIZE;
+		}
+		char* new_buffer__ = new char[new_capacity__];
+		if (buffer_)
+		{
+			memcpy(new_buffer__, buffer_, size_);
+			delete[] buffer_;
+		}
+		buffer_ = new_buffer__;
+		capacity_ = new_capacity__;
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
@@ -0,0 +1,314 @@
+/*
+ * File: TVJ_String_IO.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_String.h 1.5
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#ifdef _MSC_VER // MSVC compiler
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+#include "TVJ_String.h"
+
+namespace tvj
+{
+#define STRING_IO_BLOCK_SIZE 65536 // the least size of one block read
+
+	// write into the buffer of a string directly
+	struct _string_io
+	{
+		/**
+		 * brief: make room for at least a certain number of chars at the end
+		 * param: the string and the number of chars
+		 * return: where to write (the end of the string)
+		 */
+		static char* _tail(string& str, size_t count)
+		{
+			str._reserve(str.size_ + count + 1);
+			str._set_string_end_zero(); // not copied by the reallocation
+			return str._data() + str.size_;
+		}
+
+		/**
+		 * brief: the number of chars that can be written at the end without reallocation
+		 * param: the string
+		 * return: size_t
+		 */
+		static size_t _room(const string& str) noexcept
+		{
+			return str.capacity_ - str.size_ - 1;
+		}
+
+		/**
+		 * brief: take the chars written at the end into the string
+		 * param: the string and the number of chars
+		 * return: void
+		 */
+		static void _commit(string& str, size_t count) noexcept
+		{
+			str.size_ += count;
+			str._set_string_end_zero();
+		}
+	};
+
+	/**
+	 * brief: read until a delimiter straight into the string, growing it geometrically
+	 * param: the input stream, the string and the delimiter
+	 * return: whether the delimiter is extracted
+	 */
+	inline bool _read_line(std::istream& in, string& str, char delim)
+	{
+		str.clear();
+		for (;;)
+		{
+			char* tail__ = _string_io::_tail(str, str.size() < 256 ? 256 : str.size());
+			const std::streamsize room__ = static_cast<std::streamsize>(_string_io::_room(str));
+			in.getline(tail__, room__ + 1, delim); // the last '\0' is written to where it belongs
+			const std::streamsize got__ = in.gcount();
+			if (in.eof())
+			{
+				_string_io::_commit(str, static_cast<size_t>(got__));
+				if (!str.empty()) in.clear(in.rdstate() & ~std::ios_base::failbit);
+				return false;
+			}
+			if (!in.fail())
+			{
+				_string_io::_commit(str, static_cast<size_t>(got__ - 1)); // the delimiter is not stored
+				return true;
+			}
+			if (got__ != room__) return false;
+			// the buffer is full, grow and go on
+			_string_io::_commit(str, static_cast<size_t>(got__));
+			in.clear(in.rdstate() & ~std::ios_base::failbit);
+		}
+	}
+
+	/**
+	 * brief: read a line of any length (the delimiter is extracted but not stored)
+	 * param: the input stream, the string and the delimiter (default as '\n')
+	 * return: the input stream
+	 */
+	inline std::istream& getline(std::istream& in, string& str, char delim = '\n')
+	{
+		_read_line(in, str, delim);
+		return in;
+	}
+
+	/**
+	 * brief: read until a delimiter, the delimiter is kept at the end if it is met
+	 *        (so that the last piece without one can be told apart)
+	 * param: the input stream, the string and the delimiter
+	 * return: the input stream
+	 */
+	inline std::istream& read_until(std::istream& in, string& str, char delim)
+	{
+		if (_read_line(in, str, delim)) str.append(delim);
+		return in;
+	}
+
+	/**
+	 * brief: read everything left in the stream by large blocks
+	 * param: the input stream and the string
+	 * return: bool (false if the stream cannot be read)
+	 */
+	inline bool read_all(std::istream& in, string& str)
+	{
+		str.clear();
+		std::istream::sentry sentry__(in, true); // do not skip whitespace
+		if (!sentry__) return false;
+		std::streambuf* buf__ = in.rdbuf();
+		for (;;)
+		{
+			char* tail__ = _string_io::_tail(str, str.size() < STRING_IO_BLOCK_SIZE ? STRING_IO_BLOCK_SIZE : str.size());
+			const std::streamsize room__ = static_cast<std::streamsize>(_string_io::_room(str));
+			const std::streamsize got__ = buf__->sgetn(tail__, room__);
+			_string_io::_commit(str, static_cast<size_t>(got__));
+			if (got__ != room__) break; // the end of the stream
+		}
+		in.setstate(std::ios_base::eofbit);
+		return true;
+	}
+
+	/**
+	 * brief: read everything left in the file by large blocks
+	 * param: the file and the string
+	 * return: bool (false if there is a read error)
+	 */
+	inline bool read_all(std::FILE* file, string& str)
+	{
+		str.clear();
+		if (!file) return false;
+		for (;;)
+		{
+			char* tail__ = _string_io::_tail(str, str.size() < STRING_IO_BLOCK_SIZE ? STRING_IO_BLOCK_SIZE : str.size());
+			const size_t room__ = _string_io::_room(str);
+			const size_t got__ = std::fread(tail__, 1, room__, file);
+			_string_io::_commit(str, got__);
+			if (got__ != room__) break; // the end of the file or an error
+		}
+		return !std::ferror(file);
+	}
+
+	/**
+	 * brief: read everything left in the file descriptor by large blocks
+	 * param: the file descriptor and the string
+	 * return: bool (false if there is a read error)
+	 */
+	inline bool read_all(int fd, string& str)
+	{
+		str.clear();
+		for (;;)
+		{
+			char* tail__ = _string_io::_tail(str, str.size() < STRING_IO_BLOCK_SIZE ? STRING_IO_BLOCK_SIZE : str.size());
+			size_t room__ = _string_io::_room(str);
+#ifdef _MSC_VER
+			if (room__ > 0x40000000) room__ = 0x40000000; // _read takes an unsigned int
+			const int got__ = _read(fd, tail__, static_cast<unsigned int>(room__));
+#else
+			const ssize_t got__ = ::read(fd, tail__, room__);
+			if (got__ < 0 && errno == EINTR) continue;
+#endif
+			if (got__ < 0) return false;
+			if (got__ == 0) return true; // the end of the file
+			_string_io::_commit(str, static_cast<size_t>(got__));
+		}
+	}
+
+	// read lines one by one through a fixed block buffer,
+	// so that files of any size can be processed without loading them at once
+	class line_reader
+	{
+	public:
+
+#define LINE_READER_BUFFER_SIZE 65536 // the size of one block read
+
+		/**
+		 * brief: constructor
+		 * param: the input stream (should live longer than the reader)
+		 * return: --
+		 */
+		explicit line_reader(std::istream& in);
+
+		/**
+		 * brief: constructor
+		 * param: the file (should stay open while reading)
+		 * return: --
+		 */
+		explicit line_reader(std::FILE* file);
+
+		line_reader(const line_reader&) = delete;
+		line_reader& operator=(const line_reader&) = delete;
+
+		/**
+		 * brief: destructor
+		 * param: (void)
+		 * return: --
+		 */
+		~line_reader();
+
+		/**
+		 * brief: read the next line, '\n' is removed ('\r' is kept)
+		 * param: the string to store the line
+		 * return: bool (false if there is no more line)
+		 */
+		bool next(string& line);
+
+		/**
+		 * brief: the number of lines read so far
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t line_number() const noexcept;
+
+	private:
+
+		/**
+		 * brief: read the next block into the buffer
+		 * param: (void)
+		 * return: bool (false if nothing more can be read)
+		 */
+		bool _refill();
+
+		// the source, only one of them is used
+		std::istream* in_ = nullptr;
+		std::FILE* file_ = nullptr;
+
+		// the block buffer, [begin_, end_) is not consumed yet
+		char* buffer_ = nullptr;
+		size_t begin_ = 0;
+		size_t end_ = 0;
+
+		// the number of lines read so far
+		size_t line_number_ = 0;
+	};
+
+	inline line_reader::line_reader(std::istream& in) : in_(&in), buffer_(new char[LINE_READER_BUFFER_SIZE]) {}
+
+	inline line_reader::line_reader(std::FILE* file) : file_(file), buffer_(new char[LINE_READER_BUFFER_SIZE]) {}
+
+	inline line_reader::~line_reader()
+	{
+		delete[] buffer_;
+		buffer_ = nullptr;
+	}
+
+	inline bool line_reader::next(string& line)
+	{
+		line.clear();
+		bool has_line__ = false;
+		for (;;)
+		{
+			if (begin_ == end_ && !_refill()) break;
+			has_line__ = true;
+			const char* begin__ = buffer_ + begin_;
+			const char* found__ = static_cast<const char*>(std::memchr(begin__, '\n', end_ - begin_));
+			if (found__)
+			{
+				line.append(begin__, static_cast<size_t>(found__ - begin__));
+				begin_ = static_cast<size_t>(found__ - buffer_) + 1;
+				break;
+			}
+			line.append(begin__, end_ - begin_);
+			begin_ = end_;
+		}
+		if (has_line__) line_number_++;
+		return has_line__;
+	}
+
+	inline size_t line_reader::line_number() const noexcept
+	{
+		return line_number_;
+	}
+
+	inline bool line_reader::_refill()
+	{
+		begin_ = end_ = 0;
+		if (in_)
+		{
+			in_->read(buffer_, LINE_READER_BUFFER_SIZE);
+			end_ = static_cast<size_t>(in_->gcount());
+		}
+		else if (file_)
+		{
+			end_ = std::fread(buffer_, 1, LINE_READER_BUFFER_SIZE, file_);
+		}
+		return end_ != 0;
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
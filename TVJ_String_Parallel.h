@@ -0,0 +1,144 @@
+/*
+ * File: TVJ_String_Parallel.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_String.h 1.8, TVJ_String_Search.h 1.1
+ *
+ * @version 1.1 2026/10/18
+ * - function _parallel_search takes the length of the text only
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <thread>
+#include "TVJ_String.h"
+#include "TVJ_String_Search.h"
+
+namespace tvj
+{
+#define PARALLEL_SEARCH_MIN_CHUNK (1 << 20) // texts are not split into chunks smaller than this
+
+	/**
+	 * brief: search the chunks of a text in parallel,
+	 *        chunk k is the range of starting indices [k * chunk, (k + 1) * chunk)
+	 *        and is searched together with the next pattern_length - 1 chars,
+	 *        so that a match across the boundary is found exactly once (by the chunk it starts in)
+	 * param: the length of the text, the pattern, the number of threads (0 for the hardware concurrency)
+	 *        and the work (called with the chunk number, the offset and the length of the searched part)
+	 * return: the number of chunks
+	 */
+	template<typename Work>
+	inline unsigned _parallel_search(size_t length, const searcher& pattern, unsigned threads, Work&& work)
+	{
+		if (threads == 0) threads = std::thread::hardware_concurrency();
+		const size_t max_chunks__ = length / PARALLEL_SEARCH_MIN_CHUNK;
+		if (threads > max_chunks__) threads = static_cast<unsigned>(max_chunks__);
+		if (threads < 2)
+		{
+			work(0U, static_cast<size_t>(0), length);
+			return 1;
+		}
+		const size_t chunk__ = (length + threads - 1) / threads;
+		const size_t overlap__ = pattern.size() ? pattern.size() - 1 : 0;
+		auto run__ = [&](unsigned k)
+		{
+			const size_t begin__ = chunk__ * k;
+			if (begin__ >= length)
+			{
+				work(k, length, static_cast<size_t>(0));
+				return;
+			}
+			size_t end__ = length - begin__ > chunk__ ? begin__ + chunk__ : length;
+			end__ = length - end__ > overlap__ ? end__ + overlap__ : length;
+			work(k, begin__, end__ - begin__);
+		};
+		std::thread* workers__ = new std::thread[threads - 1];
+		for (unsigned k = 0; k != threads - 1; k++)
+		{
+			workers__[k] = std::thread(run__, k);
+		}
+		run__(threads - 1);
+		for (unsigned k = 0; k != threads - 1; k++)
+		{
+			workers__[k].join();
+		}
+		delete[] workers__;
+		return threads;
+	}
+
+	/**
+	 * brief: the indices of all occurrences of the pattern (overlapping ones included),
+	 *        the text is split into chunks searched by several threads
+	 * param: the text, the pattern and the number of threads (default as 0, i.e. the hardware concurrency)
+	 * return: vector<size_t> (in ascending order)
+	 */
+	inline vector<size_t> parallel_find_all(const string& text, const searcher& pattern, unsigned threads = 0)
+	{
+		if (threads == 0) threads = std::thread::hardware_concurrency();
+		if (threads == 0) threads = 1;
+		vector<size_t>* found__ = new vector<size_t>[threads];
+		const unsigned chunks__ = _parallel_search(text.size(), pattern, threads,
+			[&](unsigned k, size_t offset, size_t length)
+			{
+				pattern.for_each(text.data() + offset, length, [&](size_t index) { found__[k].push_back(offset + index); });
+			});
+		size_t total__ = 0;
+		for (unsigned k = 0; k != chunks__; k++) total__ += found__[k].size();
+		vector<size_t> ret(0, 0, total__ + 1);
+		for (unsigned k = 0; k != chunks__; k++)
+		{
+			for (size_t i = 0; i != found__[k].size(); i++) ret.push_back(found__[k][i]);
+		}
+		delete[] found__;
+		return ret;
+	}
+
+	/**
+	 * brief: the indices of all occurrences of a substring in parallel
+	 * param: the text, the substring and the number of threads (default as 0, i.e. the hardware concurrency)
+	 * return: vector<size_t> (in ascending order)
+	 */
+	inline vector<size_t> parallel_find_all(const string& text, const string& str, unsigned threads = 0)
+	{
+		return parallel_find_all(text, searcher(str), threads);
+	}
+
+	/**
+	 * brief: count the occurrences of the pattern (overlapping ones included),
+	 *        the text is split into chunks searched by several threads
+	 * param: the text, the pattern and the number of threads (default as 0, i.e. the hardware concurrency)
+	 * return: size_t
+	 */
+	inline size_t parallel_count(const string& text, const searcher& pattern, unsigned threads = 0)
+	{
+		if (threads == 0) threads = std::thread::hardware_concurrency();
+		if (threads == 0) threads = 1;
+		size_t* counts__ = new size_t[threads];
+		const unsigned chunks__ = _parallel_search(text.size(), pattern, threads,
+			[&](unsigned k, size_t offset, size_t length) { counts__[k] = pattern.count(text.data() + offset, length); });
+		size_t ret = 0;
+		for (unsigned k = 0; k != chunks__; k++) ret += counts__[k];
+		delete[] counts__;
+		return ret;
+	}
+
+	/**
+	 * brief: count the occurrences of a substring in parallel
+	 * param: the text, the substring and the number of threads (default as 0, i.e. the hardware concurrency)
+	 * return: size_t
+	 */
+	inline size_t parallel_count(const string& text, const string& str, unsigned threads = 0)
+	{
+		return parallel_count(text, searcher(str), threads);
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
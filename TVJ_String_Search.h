@@ -0,0 +1,520 @@
+/*
+ * File: TVJ_String_Search.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ *
+ * @version 1.1 2026/10/18
+ * - add function _search_each and searcher::for_each to visit all occurrences in one pass
+ * - function count does not restart the search after each occurrence
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TVJ_STRING_SEARCH_SSE2
+#endif
+#ifdef _MSC_VER
+#include <intrin.h> // _BitScanForward
+#endif
+
+namespace tvj
+{
+	class string;
+
+// patterns at least this long are searched by Two-Way,
+// shorter ones (but longer than one char) by the first/last byte filter
+#define TVJ_SEARCH_TWO_WAY_THRESHOLD 32
+
+	/**
+	 * brief: the index of the lowest set bit
+	 * param: unsigned (should not be 0)
+	 * return: unsigned
+	 */
+	inline unsigned _lowest_bit_index(unsigned mask) noexcept
+	{
+#ifdef _MSC_VER
+		unsigned long index__;
+		_BitScanForward(&index__, mask);
+		return static_cast<unsigned>(index__);
+#else
+		return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+	}
+
+	// the precomputed state of Two-Way (Crochemore-Perrin) for one pattern
+	struct _two_way_table
+	{
+		// the critical factorization: pattern = pattern[0, critical_] + pattern(critical_, m)
+		size_t critical_ = 0;
+
+		// the period used to shift after the left half matches
+		size_t period_ = 1;
+
+		// how much of the pattern is known to match after such a shift (0 if not periodic)
+		size_t memory_ = 0;
+
+		// last occurrence (index + 1) of each byte, 0 if not in the pattern
+		size_t shift_[256];
+
+		/**
+		 * brief: compute the critical factorization, the period and the shift table
+		 * param: the pattern and its length (at least 1)
+		 * return: void
+		 */
+		void prepare(const char* pattern, size_t length) noexcept;
+	};
+
+	/**
+	 * brief: find a single char after a certain position (memchr)
+	 * param: the text, its length, the char and the starting position
+	 * return: the index, length of the text indicating cannot find
+	 */
+	inline size_t _search_char(const char* text, size_t length, char ch, size_t pos) noexcept
+	{
+		if (pos >= length) return length;
+		const void* found__ = std::memchr(text + pos, static_cast<unsigned char>(ch), length - pos);
+		return found__ ? static_cast<const char*>(found__) - text : length;
+	}
+
+	/**
+	 * brief: visit the occurrences of the pattern after a certain position in one pass,
+	 *        candidates are filtered by its first and last char
+	 *        (16 positions at a time with SSE2) before the middle part is compared
+	 * param: the text, its length, the pattern, its length (at least 2), the starting position
+	 *        and the visitor (called with each index, returns false to stop)
+	 * return: the index where the visitor stopped, length of the text if it never did
+	 */
+	template<typename Visitor>
+	inline size_t _search_first_last_each(const char* text, size_t length, const char* pattern, size_t pattern_length,
+		size_t pos, Visitor&& visit)
+	{
+		if (pos > length || length - pos < pattern_length) return length;
+		const size_t last__ = pattern_length - 1;
+		size_t i = pos;
+#ifdef TVJ_STRING_SEARCH_SSE2
+		const __m128i first_block__ = _mm_set1_epi8(pattern[0]);
+		const __m128i last_block__ = _mm_set1_epi8(pattern[last__]);
+		for (; i + last__ + 16 <= length; i += 16)
+		{
+			const __m128i head__ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+			const __m128i tail__ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + last__));
+			unsigned mask__ = static_cast<unsigned>(_mm_movemask_epi8(
+				_mm_and_si128(_mm_cmpeq_epi8(head__, first_block__), _mm_cmpeq_epi8(tail__, last_block__))));
+			while (mask__)
+			{
+				const size_t candidate__ = i + _lowest_bit_index(mask__);
+				if (std::memcmp(text + candidate__ + 1, pattern + 1, last__ - 1) == 0 && !visit(candidate__)) return candidate__;
+				mask__ &= mask__ - 1;
+			}
+		}
+#endif
+		while (i + last__ < length)
+		{
+			const void* found__ = std::memchr(text + i, static_cast<unsigned char>(pattern[0]), length - last__ - i);
+			if (!found__) return length;
+			i = static_cast<const char*>(found__) - text;
+			if (text[i + last__] == pattern[last__] && std::memcmp(text + i + 1, pattern + 1, last__ - 1) == 0 && !visit(i)) return i;
+			i++;
+		}
+		return length;
+	}
+
+	/**
+	 * brief: find the pattern after a certain position by the first/last char filter
+	 * param: the text, its length, the pattern, its length (at least 2) and the starting position
+	 * return: the index, length of the text indicating cannot find
+	 */
+	inline size_t _search_first_last(const char* text, size_t length, const char* pattern, size_t pattern_length, size_t pos) noexcept
+	{
+		return _search_first_last_each(text, length, pattern, pattern_length, pos, [](size_t) { return false; });
+	}
+
+	/**
+	 * brief: visit the occurrences of the pattern after a certain position by Two-Way in one pass,
+	 *        linear in the length of the text with constant extra space
+	 *        (after a match the shift keeps what is known to match, as after a partial match)
+	 * param: the text, its length, the pattern, its length (at least 1),
+	 *        the precomputed table, the starting position
+	 *        and the visitor (called with each index, returns false to stop)
+	 * return: the index where the visitor stopped, length of the text if it never did
+	 */
+	template<typename Visitor>
+	inline size_t _search_two_way_each(const char* text, size_t length, const char* pattern, size_t pattern_length,
+		const _two_way_table& table, size_t pos, Visitor&& visit)
+	{
+		if (pos > length) return length;
+		const unsigned char* h__ = reinterpret_cast<const unsigned char*>(text) + pos;
+		const unsigned char* z__ = reinterpret_cast<const unsigned char*>(text) + length;
+		const unsigned char* n__ = reinterpret_cast<const unsigned char*>(pattern);
+		const size_t l__ = pattern_length;
+		size_t mem__ = 0;
+		while (static_cast<size_t>(z__ - h__) >= l__)
+		{
+			// check the last char first, and skip by the bad char shift on mismatch
+			const size_t shift__ = table.shift_[h__[l__ - 1]];
+			if (!shift__)
+			{
+				h__ += l__;
+				mem__ = 0;
+				continue;
+			}
+			if (shift__ != l__)
+			{
+				h__ += (l__ - shift__ < mem__) ? mem__ : l__ - shift__;
+				mem__ = 0;
+				continue;
+			}
+
+			// compare the right half
+			size_t k__ = table.critical_ + 1 > mem__ ? table.critical_ + 1 : mem__;
+			while (k__ < l__ && n__[k__] == h__[k__]) k__++;
+			if (k__ < l__)
+			{
+				h__ += k__ - table.critical_;
+				mem__ = 0;
+				continue;
+			}
+
+			// compare the left half
+			for (k__ = table.critical_ + 1; k__ > mem__ && n__[k__ - 1] == h__[k__ - 1]; k__--);
+			if (k__ <= mem__)
+			{
+				const size_t found__ = reinterpret_cast<const char*>(h__) - text;
+				if (!visit(found__)) return found__;
+			}
+			h__ += table.period_;
+			mem__ = table.memory_;
+		}
+		return length;
+	}
+
+	/**
+	 * brief: find the pattern after a certain position by Two-Way
+	 * param: the text, its length, the pattern, its length (at least 1),
+	 *        the precomputed table and the starting position
+	 * return: the index, length of the text indicating cannot find
+	 */
+	inline size_t _search_two_way(const char* text, size_t length, const char* pattern, size_t pattern_length,
+		const _two_way_table& table, size_t pos) noexcept
+	{
+		return _search_two_way_each(text, length, pattern, pattern_length, table, pos, [](size_t) { return false; });
+	}
+
+	inline void _two_way_table::prepare(const char* pattern, size_t length) noexcept
+	{
+		const unsigned char* n__ = reinterpret_cast<const unsigned char*>(pattern);
+		for (size_t i = 0; i != 256; i++) shift_[i] = 0;
+		for (size_t i = 0; i != length; i++) shift_[n__[i]] = i + 1;
+
+		// maximal suffix for '<' and for '>',
+		// the larger one of the two gives the critical factorization
+		size_t ip__ = static_cast<size_t>(-1), jp__ = 0, k__ = 1, p__ = 1;
+		while (jp__ + k__ < length)
+		{
+			if (n__[ip__ + k__] == n__[jp__ + k__])
+			{
+				if (k__ == p__)
+				{
+					jp__ += p__;
+					k__ = 1;
+				}
+				else k__++;
+			}
+			else if (n__[ip__ + k__] > n__[jp__ + k__])
+			{
+				jp__ += k__;
+				k__ = 1;
+				p__ = jp__ - ip__;
+			}
+			else
+			{
+				ip__ = jp__++;
+				k__ = p__ = 1;
+			}
+		}
+		size_t critical__ = ip__;
+		const size_t first_period__ = p__;
+
+		ip__ = static_cast<size_t>(-1); jp__ = 0; k__ = p__ = 1;
+		while (jp__ + k__ < length)
+		{
+			if (n__[ip__ + k__] == n__[jp__ + k__])
+			{
+				if (k__ == p__)
+				{
+					jp__ += p__;
+					k__ = 1;
+				}
+				else k__++;
+			}
+			else if (n__[ip__ + k__] < n__[jp__ + k__])
+			{
+				jp__ += k__;
+				k__ = 1;
+				p__ = jp__ - ip__;
+			}
+			else
+			{
+				ip__ = jp__++;
+				k__ = p__ = 1;
+			}
+		}
+		if (ip__ + 1 > critical__ + 1) critical__ = ip__;
+		else p__ = first_period__;
+
+		critical_ = critical__;
+		if (std::memcmp(n__, n__ + p__, critical__ + 1))
+		{
+			// not periodic, the shift can be as long as the larger half
+			period_ = (critical__ > length - critical__ - 1 ? critical__ : length - critical__ - 1) + 1;
+			memory_ = 0;
+		}
+		else
+		{
+			period_ = p__;
+			memory_ = length - p__;
+		}
+	}
+
+	/**
+	 * brief: find the pattern after a certain position,
+	 *        choosing memchr, the first/last byte filter or Two-Way by the pattern length
+	 * param: the text, its length, the pattern, its length and the starting position
+	 * return: the index, length of the text indicating cannot find
+	 */
+	inline size_t _search(const char* text, size_t length, const char* pattern, size_t pattern_length, size_t pos) noexcept
+	{
+		if (pattern_length == 0) return pos <= length ? pos : length;
+		if (pattern_length == 1) return _search_char(text, length, pattern[0], pos);
+		if (pattern_length < TVJ_SEARCH_TWO_WAY_THRESHOLD) return _search_first_last(text, length, pattern, pattern_length, pos);
+		if (pos > length || length - pos < pattern_length) return length;
+		_two_way_table table__;
+		table__.prepare(pattern, pattern_length);
+		return _search_two_way(text, length, pattern, pattern_length, table__, pos);
+	}
+
+	/**
+	 * brief: visit all occurrences of the pattern (overlapping ones included) in one pass,
+	 *        without restarting the search after each of them
+	 * param: the text, its length, the pattern, its length (at least 1),
+	 *        the Two-Way table (nullptr if the pattern is shorter than TVJ_SEARCH_TWO_WAY_THRESHOLD)
+	 *        and the visitor (called with each index)
+	 * return: void
+	 */
+	template<typename Visitor>
+	inline void _search_each(const char* text, size_t length, const char* pattern, size_t pattern_length,
+		const _two_way_table* table, Visitor&& visit)
+	{
+		if (pattern_length == 1)
+		{
+			for (size_t i = _search_char(text, length, pattern[0], 0); i != length; i = _search_char(text, length, pattern[0], i + 1))
+			{
+				visit(i);
+			}
+		}
+		else if (table)
+		{
+			_search_two_way_each(text, length, pattern, pattern_length, *table, 0, [&visit](size_t index) { visit(index); return true; });
+		}
+		else
+		{
+			_search_first_last_each(text, length, pattern, pattern_length, 0, [&visit](size_t index) { visit(index); return true; });
+		}
+	}
+
+	// a precompiled pattern that can be searched in many texts
+	class searcher
+	{
+	public:
+
+		/**
+		 * brief: constructor
+		 * param: the pattern (a c-style string)
+		 * return: --
+		 */
+		explicit searcher(const char* pattern);
+
+		/**
+		 * brief: constructor
+		 * param: the pattern and its length
+		 * return: --
+		 */
+		explicit searcher(const char* pattern, size_t length);
+
+		/**
+		 * brief: constructor (defined in TVJ_String.h)
+		 * param: the pattern
+		 * return: --
+		 */
+		explicit searcher(const string& pattern);
+
+		/**
+		 * brief: copy constructor
+		 * param: another searcher
+		 * return: --
+		 */
+		searcher(const searcher& another);
+
+		/**
+		 * brief: destructor
+		 * param: (void)
+		 * return: --
+		 */
+		~searcher();
+
+		/**
+		 * brief: copy
+		 * param: another searcher
+		 * return: the copied searcher (read & write)
+		 */
+		searcher& operator=(const searcher& another);
+
+		/**
+		 * brief: the length of the pattern
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: find the pattern after a certain position (default as 0)
+		 * param: the text, its length and the starting position
+		 * return: the index, length of the text indicating cannot find
+		 */
+		size_t find(const char* text, size_t length, size_t pos = 0) const noexcept;
+
+		/**
+		 * brief: find the pattern after a certain position (default as 0) (defined in TVJ_String.h)
+		 * param: the text and the starting position
+		 * return: the index, size of the text indicating cannot find
+		 */
+		size_t find(const string& text, size_t pos = 0) const noexcept;
+
+		/**
+		 * brief: count the occurrences of the pattern (overlapping ones included)
+		 * param: the text and its length
+		 * return: size_t
+		 */
+		size_t count(const char* text, size_t length) const noexcept;
+
+		/**
+		 * brief: count the occurrences of the pattern (defined in TVJ_String.h)
+		 * param: the text
+		 * return: size_t
+		 */
+		size_t count(const string& text) const noexcept;
+
+		/**
+		 * brief: visit all occurrences of the pattern (overlapping ones included) in one pass
+		 * param: the text, its length and the visitor (called with each index)
+		 * return: void
+		 */
+		template<typename Visitor>
+		void for_each(const char* text, size_t length, Visitor&& visit) const;
+
+	private:
+
+		/**
+		 * brief: copy the pattern and prepare the table if Two-Way is used
+		 * param: the pattern and its length
+		 * return: void
+		 */
+		void _compile(const char* pattern, size_t length);
+
+		// the copy of the pattern
+		char* pattern_ = nullptr;
+
+		// the length of the pattern
+		size_t length_ = 0;
+
+		// only allocated for patterns no shorter than TVJ_SEARCH_TWO_WAY_THRESHOLD
+		_two_way_table* table_ = nullptr;
+	};
+
+	inline searcher::searcher(const char* pattern)
+	{
+		_compile(pattern, pattern ? std::strlen(pattern) : 0);
+	}
+
+	inline searcher::searcher(const char* pattern, size_t length)
+	{
+		_compile(pattern, length);
+	}
+
+	inline searcher::searcher(const searcher& another)
+	{
+		_compile(another.pattern_, another.length_);
+	}
+
+	inline searcher::~searcher()
+	{
+		delete[] pattern_;
+		delete table_;
+	}
+
+	inline searcher& searcher::operator=(const searcher& another)
+	{
+		if (this != &another)
+		{
+			delete[] pattern_;
+			delete table_;
+			pattern_ = nullptr;
+			table_ = nullptr;
+			_compile(another.pattern_, another.length_);
+		}
+		return *this;
+	}
+
+	inline size_t searcher::size() const noexcept
+	{
+		return length_;
+	}
+
+	inline size_t searcher::find(const char* text, size_t length, size_t pos) const noexcept
+	{
+		if (table_)
+		{
+			return _search_two_way(text, length, pattern_, length_, *table_, pos);
+		}
+		return _search(text, length, pattern_, length_, pos);
+	}
+
+	inline size_t searcher::count(const char* text, size_t length) const noexcept
+	{
+		size_t count__ = 0;
+		for_each(text, length, [&count__](size_t) { count__++; });
+		return count__;
+	}
+
+	template<typename Visitor>
+	inline void searcher::for_each(const char* text, size_t length, Visitor&& visit) const
+	{
+		if (length_ == 0) return;
+		_search_each(text, length, pattern_, length_, table_, visit);
+	}
+
+	inline void searcher::_compile(const char* pattern, size_t length)
+	{
+		length_ = length;
+		pattern_ = new char[length + 1];
+		if (length) std::memcpy(pattern_, pattern, length);
+		pattern_[length] = 0;
+		if (length >= TVJ_SEARCH_TWO_WAY_THRESHOLD)
+		{
+			table_ = new _two_way_table;
+			table_->prepare(pattern_, length_);
+		}
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
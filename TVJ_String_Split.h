@@ -0,0 +1,363 @@
+/*
+ * File: TVJ_String_Split.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_String_View.h 1.0, TVJ_String_Search.h 1.1
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include "TVJ_String_View.h"
+#include "TVJ_String_Search.h"
+
+namespace tvj
+{
+#define SPLIT_SIMD_DELIMITERS 8 // sets up to this size are scanned 16 chars at a time with SSE2
+
+	// a set of delimiter chars with a scan for the next one in a text
+	class delimiter_set
+	{
+	public:
+
+		/**
+		 * brief: constructor
+		 * param: the delimiter chars
+		 * return: --
+		 */
+		explicit delimiter_set(const string_view& delims) noexcept;
+
+		/**
+		 * brief: check if a char is a delimiter
+		 * param: the char
+		 * return: bool
+		 */
+		bool operator()(char ch) const noexcept;
+
+		/**
+		 * brief: find the next delimiter after a certain position
+		 *        (memchr for a single delimiter, 16 chars at a time with SSE2 for a small set)
+		 * param: the text, its length and the starting position
+		 * return: the index, length of the text indicating cannot find
+		 */
+		size_t find(const char* text, size_t length, size_t pos) const noexcept;
+
+	private:
+
+		// whether each char is a delimiter
+		bool table_[256];
+
+		// the distinct delimiters (only the first SPLIT_SIMD_DELIMITERS are kept)
+		char chars_[SPLIT_SIMD_DELIMITERS];
+
+		// the number of distinct delimiters
+		size_t count_ = 0;
+	};
+
+	inline delimiter_set::delimiter_set(const string_view& delims) noexcept
+	{
+		for (size_t i = 0; i != 256; i++) table_[i] = false;
+		for (size_t i = 0; i != delims.size(); i++)
+		{
+			const unsigned char ch = static_cast<unsigned char>(delims[i]);
+			if (table_[ch]) continue;
+			table_[ch] = true;
+			if (count_ < SPLIT_SIMD_DELIMITERS) chars_[count_] = delims[i];
+			count_++;
+		}
+	}
+
+	inline bool delimiter_set::operator()(char ch) const noexcept
+	{
+		return table_[static_cast<unsigned char>(ch)];
+	}
+
+	inline size_t delimiter_set::find(const char* text, size_t length, size_t pos) const noexcept
+	{
+		if (count_ == 0) return length;
+		if (count_ == 1) return _search_char(text, length, chars_[0], pos);
+		size_t i = pos;
+#ifdef TVJ_STRING_SEARCH_SSE2
+		if (count_ <= SPLIT_SIMD_DELIMITERS)
+		{
+			__m128i delims__[SPLIT_SIMD_DELIMITERS];
+			for (size_t k = 0; k != count_; k++) delims__[k] = _mm_set1_epi8(chars_[k]);
+			for (; i + 16 <= length; i += 16)
+			{
+				const __m128i block__ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+				__m128i hit__ = _mm_cmpeq_epi8(block__, delims__[0]);
+				for (size_t k = 1; k != count_; k++) hit__ = _mm_or_si128(hit__, _mm_cmpeq_epi8(block__, delims__[k]));
+				const unsigned mask__ = static_cast<unsigned>(_mm_movemask_epi8(hit__));
+				if (mask__) return i + _lowest_bit_index(mask__);
+			}
+		}
+#endif
+		for (; i < length; i++)
+		{
+			if (table_[static_cast<unsigned char>(text[i])]) return i;
+		}
+		return length;
+	}
+
+	/**
+	 * brief: find the next char satisfying a predicate after a certain position
+	 * param: the predicate, the text, its length and the starting position
+	 * return: the index, length of the text indicating cannot find
+	 */
+	template<typename Predicate>
+	inline size_t _find_delimiter(const Predicate& is_delimiter, const char* text, size_t length, size_t pos)
+	{
+		while (pos < length && !is_delimiter(text[pos])) pos++;
+		return pos;
+	}
+
+	/**
+	 * brief: find the next delimiter after a certain position (SIMD for a delimiter set)
+	 * param: the delimiter set, the text, its length and the starting position
+	 * return: the index, length of the text indicating cannot find
+	 */
+	inline size_t _find_delimiter(const delimiter_set& delims, const char* text, size_t length, size_t pos) noexcept
+	{
+		return delims.find(text, length, pos);
+	}
+
+	// the fields of a text separated by any of the delimiters, found lazily,
+	// n delimiters give n + 1 fields (empty ones included)
+	// and each field refers to the text without copying
+	class split_range
+	{
+	public:
+
+		class const_iterator
+		{
+		public:
+			const_iterator(const split_range* range, size_t begin) noexcept;
+			string_view operator*() const noexcept;
+			const_iterator& operator++() noexcept;
+			const_iterator operator++(int) noexcept;
+			bool operator==(const const_iterator& iter) const noexcept;
+			bool operator!=(const const_iterator& iter) const noexcept;
+
+		private:
+			const split_range* range_;
+
+			// the field is [begin_, end_), begin_ is one past the length at the end
+			size_t begin_;
+			size_t end_;
+		};
+
+		/**
+		 * brief: constructor
+		 * param: the text (which must outlive the range) and the delimiter chars
+		 * return: --
+		 */
+		split_range(const string_view& text, const string_view& delims) noexcept;
+
+		const_iterator begin() const noexcept;
+		const_iterator end() const noexcept;
+
+	private:
+		string_view text_;
+		delimiter_set delims_;
+	};
+
+	inline split_range::const_iterator::const_iterator(const split_range* range, size_t begin) noexcept
+		: range_(range), begin_(begin), end_(begin)
+	{
+		if (begin_ <= range_->text_.size())
+		{
+			end_ = range_->delims_.find(range_->text_.data(), range_->text_.size(), begin_);
+		}
+	}
+
+	inline string_view split_range::const_iterator::operator*() const noexcept
+	{
+		return string_view(range_->text_.data() + begin_, end_ - begin_);
+	}
+
+	inline split_range::const_iterator& split_range::const_iterator::operator++() noexcept
+	{
+		begin_ = end_ + 1;
+		if (begin_ <= range_->text_.size())
+		{
+			end_ = range_->delims_.find(range_->text_.data(), range_->text_.size(), begin_);
+		}
+		return *this;
+	}
+
+	inline split_range::const_iterator split_range::const_iterator::operator++(int) noexcept
+	{
+		const_iterator ret = *this;
+		++*this;
+		return ret;
+	}
+
+	inline bool split_range::const_iterator::operator==(const const_iterator& iter) const noexcept
+	{
+		return begin_ == iter.begin_;
+	}
+
+	inline bool split_range::const_iterator::operator!=(const const_iterator& iter) const noexcept
+	{
+		return begin_ != iter.begin_;
+	}
+
+	inline split_range::split_range(const string_view& text, const string_view& delims) noexcept
+		: text_(text), delims_(delims) { }
+
+	inline split_range::const_iterator split_range::begin() const noexcept
+	{
+		return const_iterator(this, 0);
+	}
+
+	inline split_range::const_iterator split_range::end() const noexcept
+	{
+		return const_iterator(this, text_.size() + 1);
+	}
+
+	// the tokens of a text, i.e. the non-empty runs of chars that are not delimiters, found lazily,
+	// each token refers to the text without copying
+	template<typename Predicate>
+	class token_range
+	{
+	public:
+
+		class const_iterator
+		{
+		public:
+			const_iterator(const token_range* range, size_t begin) noexcept;
+			string_view operator*() const noexcept;
+			const_iterator& operator++() noexcept;
+			const_iterator operator++(int) noexcept;
+			bool operator==(const const_iterator& iter) const noexcept;
+			bool operator!=(const const_iterator& iter) const noexcept;
+
+		private:
+
+			/**
+			 * brief: skip the delimiters from begin_ and find the end of the token
+			 * param: (void)
+			 * return: void
+			 */
+			void _next() noexcept;
+
+			const token_range* range_;
+
+			// the token is [begin_, end_), begin_ is the length at the end
+			size_t begin_;
+			size_t end_;
+		};
+
+		/**
+		 * brief: constructor
+		 * param: the text (which must outlive the range) and the predicate telling the delimiters
+		 * return: --
+		 */
+		token_range(const string_view& text, const Predicate& is_delimiter);
+
+		const_iterator begin() const noexcept;
+		const_iterator end() const noexcept;
+
+	private:
+		string_view text_;
+		Predicate is_delimiter_;
+	};
+
+	template<typename Predicate>
+	inline token_range<Predicate>::const_iterator::const_iterator(const token_range* range, size_t begin) noexcept
+		: range_(range), begin_(begin), end_(begin)
+	{
+		_next();
+	}
+
+	template<typename Predicate>
+	inline string_view token_range<Predicate>::const_iterator::operator*() const noexcept
+	{
+		return string_view(range_->text_.data() + begin_, end_ - begin_);
+	}
+
+	template<typename Predicate>
+	inline typename token_range<Predicate>::const_iterator& token_range<Predicate>::const_iterator::operator++() noexcept
+	{
+		begin_ = end_;
+		_next();
+		return *this;
+	}
+
+	template<typename Predicate>
+	inline typename token_range<Predicate>::const_iterator token_range<Predicate>::const_iterator::operator++(int) noexcept
+	{
+		const_iterator ret = *this;
+		++*this;
+		return ret;
+	}
+
+	template<typename Predicate>
+	inline bool token_range<Predicate>::const_iterator::operator==(const const_iterator& iter) const noexcept
+	{
+		return begin_ == iter.begin_;
+	}
+
+	template<typename Predicate>
+	inline bool token_range<Predicate>::const_iterator::operator!=(const const_iterator& iter) const noexcept
+	{
+		return begin_ != iter.begin_;
+	}
+
+	template<typename Predicate>
+	inline void token_range<Predicate>::const_iterator::_next() noexcept
+	{
+		const char* text__ = range_->text_.data();
+		const size_t length__ = range_->text_.size();
+		while (begin_ < length__ && range_->is_delimiter_(text__[begin_])) begin_++;
+		end_ = begin_ < length__ ? _find_delimiter(range_->is_delimiter_, text__, length__, begin_ + 1) : length__;
+	}
+
+	template<typename Predicate>
+	inline token_range<Predicate>::token_range(const string_view& text, const Predicate& is_delimiter)
+		: text_(text), is_delimiter_(is_delimiter) { }
+
+	template<typename Predicate>
+	inline typename token_range<Predicate>::const_iterator token_range<Predicate>::begin() const noexcept
+	{
+		return const_iterator(this, 0);
+	}
+
+	template<typename Predicate>
+	inline typename token_range<Predicate>::const_iterator token_range<Predicate>::end() const noexcept
+	{
+		return const_iterator(this, text_.size());
+	}
+
+	/**
+	 * brief: split a text by any of the delimiter chars (empty fields included)
+	 * param: the text (which must outlive the range) and the delimiter chars
+	 * return: split_range (of string_view)
+	 */
+	inline split_range split(const string_view& text, const string_view& delims) noexcept
+	{
+		return split_range(text, delims);
+	}
+
+	/**
+	 * brief: the tokens of a text separated by the chars satisfying a predicate (empty tokens skipped),
+	 *        a delimiter_set as the predicate scans with SIMD
+	 * param: the text (which must outlive the range) and the predicate telling the delimiters
+	 * return: token_range (of string_view)
+	 */
+	template<typename Predicate>
+	inline token_range<Predicate> tokenize(const string_view& text, const Predicate& is_delimiter)
+	{
+		return token_range<Predicate>(text, is_delimiter);
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
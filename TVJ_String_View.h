@@ -0,0 +1,257 @@
+/*
+ * File: TVJ_String_View.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_String.h 1.6, TVJ_String_Search.h 1.0
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstring>
+#include <iostream>
+#include "TVJ_String.h"
+#include "TVJ_String_Search.h"
+
+namespace tvj
+{
+	// a read-only reference to a char array that does not own it,
+	// it is valid only as long as the referred chars are
+	class string_view
+	{
+	public:
+
+		/**
+		 * brief: default constructor, an empty view
+		 * param: (void)
+		 * return: --
+		 */
+		string_view() noexcept;
+
+		/**
+		 * brief: constructor from a C-style string
+		 * param: the C-style string
+		 * return: --
+		 */
+		string_view(const char* str) noexcept;
+
+		/**
+		 * brief: constructor from a char array
+		 * param: the char array and its length
+		 * return: --
+		 */
+		string_view(const char* str, size_t length) noexcept;
+
+		/**
+		 * brief: constructor from a string (invalidated when the string is changed)
+		 * param: the string
+		 * return: --
+		 */
+		string_view(const string& str) noexcept;
+
+		/**
+		 * brief: the referred chars (not necessarily ended with '\0')
+		 * param: (void)
+		 * return: const char*
+		 */
+		const char* data() const noexcept;
+
+		/**
+		 * brief: the number of chars
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: the number of chars, the alias of size
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t length() const noexcept;
+
+		/**
+		 * brief: check if the view is empty
+		 * param: (void)
+		 * return: bool
+		 */
+		bool empty() const noexcept;
+
+		/**
+		 * brief: return char at the certain index
+		 * param: size_t index
+		 * return: const char&
+		 */
+		const char& operator[](size_t index) const;
+
+		/**
+		 * brief: the first char (for range-based for)
+		 * param: (void)
+		 * return: const char*
+		 */
+		const char* begin() const noexcept;
+
+		/**
+		 * brief: one past the last char (for range-based for)
+		 * param: (void)
+		 * return: const char*
+		 */
+		const char* end() const noexcept;
+
+		/**
+		 * brief: a part of the view
+		 * param: the start position and the number of chars (cut at the end)
+		 * return: string_view
+		 */
+		string_view substr(size_t pos, size_t count = static_cast<size_t>(-1)) const;
+
+		/**
+		 * brief: find substring after a certain position (default as 0),
+		 *        return the index, one past of the last indicating cannot find
+		 * param: the substring and the starting position
+		 * return: size_t
+		 */
+		size_t find(const string_view& str, size_t pos = 0) const noexcept;
+
+		/**
+		 * brief: check if the view begins with a certain prefix
+		 * param: the prefix
+		 * return: bool
+		 */
+		bool starts_with(const string_view& str) const noexcept;
+
+		/**
+		 * brief: check if the view ends with a certain suffix
+		 * param: the suffix
+		 * return: bool
+		 */
+		bool ends_with(const string_view& str) const noexcept;
+
+		/**
+		 * brief: copy the chars into a string
+		 * param: (void)
+		 * return: string
+		 */
+		string to_string() const;
+
+		// @ relationship operators
+		bool operator==(const string_view& str) const noexcept;
+		bool operator!=(const string_view& str) const noexcept;
+		bool operator<(const string_view& str) const noexcept;
+
+	private:
+
+		// the referred chars
+		const char* data_;
+
+		// the number of chars
+		size_t size_;
+	};
+
+	inline string_view::string_view() noexcept : data_(""), size_(0) {}
+
+	inline string_view::string_view(const char* str) noexcept : data_(str ? str : ""), size_(str ? strlen(str) : 0) {}
+
+	inline string_view::string_view(const char* str, size_t length) noexcept : data_(str), size_(length) {}
+
+	inline string_view::string_view(const string& str) noexcept : data_(str.data()), size_(str.size()) {}
+
+	inline const char* string_view::data() const noexcept
+	{
+		return data_;
+	}
+
+	inline size_t string_view::size() const noexcept
+	{
+		return size_;
+	}
+
+	inline size_t string_view::length() const noexcept
+	{
+		return size_;
+	}
+
+	inline bool string_view::empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	inline const char& string_view::operator[](size_t index) const
+	{
+#ifndef NDEBUG
+		if (index >= size_) error_info("Overflow in operator[] of tvj::string_view", TVJ_STRING_OVERFLOW);
+#endif
+		return data_[index];
+	}
+
+	inline const char* string_view::begin() const noexcept
+	{
+		return data_;
+	}
+
+	inline const char* string_view::end() const noexcept
+	{
+		return data_ + size_;
+	}
+
+	inline string_view string_view::substr(size_t pos, size_t count) const
+	{
+#ifndef NDEBUG
+		if (pos > size_) error_info("Overflow in substr of tvj::string_view", TVJ_STRING_OVERFLOW);
+#endif
+		if (count > size_ - pos) count = size_ - pos;
+		return string_view(data_ + pos, count);
+	}
+
+	inline size_t string_view::find(const string_view& str, size_t pos) const noexcept
+	{
+		return _search(data_, size_, str.data_, str.size_, pos);
+	}
+
+	inline bool string_view::starts_with(const string_view& str) const noexcept
+	{
+		return str.size_ <= size_ && memcmp(data_, str.data_, str.size_) == 0;
+	}
+
+	inline bool string_view::ends_with(const string_view& str) const noexcept
+	{
+		return str.size_ <= size_ && memcmp(data_ + size_ - str.size_, str.data_, str.size_) == 0;
+	}
+
+	inline string string_view::to_string() const
+	{
+		string ret;
+		ret.append(data_, size_);
+		return ret;
+	}
+
+	inline bool string_view::operator==(const string_view& str) const noexcept
+	{
+		return size_ == str.size_ && memcmp(data_, str.data_, size_) == 0;
+	}
+
+	inline bool string_view::operator!=(const string_view& str) const noexcept
+	{
+		return !(*this == str);
+	}
+
+	inline bool string_view::operator<(const string_view& str) const noexcept
+	{
+		const int compare__ = memcmp(data_, str.data_, size_ < str.size_ ? size_ : str.size_);
+		return compare__ < 0 || (compare__ == 0 && size_ < str.size_);
+	}
+
+	inline std::ostream& operator<<(std::ostream& out, const string_view& str)
+	{
+		out.write(str.data(), static_cast<std::streamsize>(str.size()));
+		return out;
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
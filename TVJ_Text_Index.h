@@ -0,0 +1,743 @@
+/*
+ * File: TVJ_Text_Index.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ * @reliance: TVJ_String.h 1.9
+ *
+ * @version 1.1 2026/10/18
+ * - load checks the tables against the BWT, so a damaged file is rejected instead of making queries read out of the arrays
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "TVJ_String.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TVJ_TEXT_INDEX_SSE2
+#endif
+#ifdef _MSC_VER
+#include <intrin.h> // __popcnt64
+#endif
+
+// The suffix array is built by SA-IS (Nong, Zhang and Chan, "Two Efficient Algorithms for Linear Time Suffix Array Construction"),
+// then only the FM-index is kept: the BWT, occurrence checkpoints and a sample of the suffix array.
+
+namespace tvj
+{
+#define TEXT_INDEX_OCC_RATE 64      // rows between two occurrence checkpoints
+#define TEXT_INDEX_SA_RATE  32      // text positions between two suffix array samples
+#define TEXT_INDEX_EMPTY 0xFFFFFFFFu // an empty slot of the suffix array during construction
+
+	/**
+	 * brief: the number of set bits
+	 * param: uint64_t
+	 * return: unsigned
+	 */
+	inline unsigned _index_popcount(uint64_t bits) noexcept
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		return static_cast<unsigned>(__popcnt64(bits));
+#elif defined(_MSC_VER)
+		return __popcnt(static_cast<unsigned>(bits)) + __popcnt(static_cast<unsigned>(bits >> 32));
+#else
+		return static_cast<unsigned>(__builtin_popcountll(bits));
+#endif
+	}
+
+	/**
+	 * brief: the number of a certain byte in a range (16 bytes at a time with SSE2)
+	 * param: the bytes, the number of bytes and the byte
+	 * return: size_t
+	 */
+	inline size_t _index_count_byte(const unsigned char* p, size_t length, unsigned char ch) noexcept
+	{
+		size_t count__ = 0;
+		size_t i = 0;
+#ifdef TVJ_TEXT_INDEX_SSE2
+		const __m128i target__ = _mm_set1_epi8(static_cast<char>(ch));
+		for (; i + 16 <= length; i += 16)
+		{
+			const __m128i block__ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			count__ += _index_popcount(static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block__, target__))));
+		}
+#endif
+		for (; i != length; i++) count__ += p[i] == ch;
+		return count__;
+	}
+
+	/**
+	 * brief: the start (or one past the end) of each bucket
+	 * param: the string, its length, the size of the alphabet, the buckets and whether to get the ends
+	 * return: void
+	 */
+	inline void _sais_buckets(const uint32_t* s, uint32_t n, uint32_t k, uint32_t* bucket, bool end) noexcept
+	{
+		for (uint32_t c = 0; c != k; c++) bucket[c] = 0;
+		for (uint32_t i = 0; i != n; i++) bucket[s[i]]++;
+		uint32_t sum__ = 0;
+		for (uint32_t c = 0; c != k; c++)
+		{
+			sum__ += bucket[c];
+			bucket[c] = end ? sum__ : sum__ - bucket[c];
+		}
+	}
+
+	/**
+	 * brief: induce the order of the L-type and then the S-type suffixes from the sorted LMS suffixes
+	 * param: the string, its types, the suffix array, the length, the size of the alphabet and the buckets
+	 * return: void
+	 */
+	inline void _sais_induce(const uint32_t* s, const unsigned char* type, uint32_t* sa, uint32_t n, uint32_t k, uint32_t* bucket) noexcept
+	{
+		_sais_buckets(s, n, k, bucket, false);
+		for (uint32_t i = 0; i != n; i++)
+		{
+			if (sa[i] != TEXT_INDEX_EMPTY && sa[i] > 0 && !type[sa[i] - 1]) sa[bucket[s[sa[i] - 1]]++] = sa[i] - 1;
+		}
+		_sais_buckets(s, n, k, bucket, true);
+		for (uint32_t i = n; i-- > 0;)
+		{
+			if (sa[i] != TEXT_INDEX_EMPTY && sa[i] > 0 && type[sa[i] - 1]) sa[--bucket[s[sa[i] - 1]]] = sa[i] - 1;
+		}
+	}
+
+	/**
+	 * brief: build the suffix array by SA-IS in linear time
+	 * param: the string (ended with a unique 0, the smallest), the suffix array, the length and the size of the alphabet
+	 * return: void
+	 */
+	inline void _sais(const uint32_t* s, uint32_t* sa, uint32_t n, uint32_t k)
+	{
+		if (n == 1)
+		{
+			sa[0] = 0;
+			return;
+		}
+
+		// type of each suffix: 1 for S (smaller than the next one), 0 for L
+		unsigned char* type__ = new unsigned char[n];
+		type__[n - 1] = 1;
+		for (uint32_t i = n - 1; i-- > 0;)
+		{
+			type__[i] = s[i] < s[i + 1] || (s[i] == s[i + 1] && type__[i + 1]);
+		}
+		auto is_lms__ = [type__](uint32_t i) { return i > 0 && type__[i] && !type__[i - 1]; };
+		uint32_t* bucket__ = new uint32_t[k];
+
+		// sort the LMS substrings
+		_sais_buckets(s, n, k, bucket__, true);
+		for (uint32_t i = 0; i != n; i++) sa[i] = TEXT_INDEX_EMPTY;
+		for (uint32_t i = 1; i != n; i++)
+		{
+			if (is_lms__(i)) sa[--bucket__[s[i]]] = i;
+		}
+		_sais_induce(s, type__, sa, n, k, bucket__);
+
+		// put the sorted LMS substrings at the front and name them
+		uint32_t n1__ = 0;
+		for (uint32_t i = 0; i != n; i++)
+		{
+			if (is_lms__(sa[i])) sa[n1__++] = sa[i];
+		}
+		for (uint32_t i = n1__; i != n; i++) sa[i] = TEXT_INDEX_EMPTY;
+		uint32_t name__ = 0, prev__ = TEXT_INDEX_EMPTY;
+		for (uint32_t i = 0; i != n1__; i++)
+		{
+			const uint32_t pos__ = sa[i];
+			bool diff__ = false;
+			for (uint32_t d = 0; d != n; d++)
+			{
+				if (prev__ == TEXT_INDEX_EMPTY || s[pos__ + d] != s[prev__ + d] || type__[pos__ + d] != type__[prev__ + d])
+				{
+					diff__ = true;
+					break;
+				}
+				if (d > 0 && (is_lms__(pos__ + d) || is_lms__(prev__ + d))) break;
+			}
+			if (diff__)
+			{
+				name__++;
+				prev__ = pos__;
+			}
+			sa[n1__ + pos__ / 2] = name__ - 1; // no two LMS positions are adjacent
+		}
+		for (uint32_t i = n, j = n; i-- > n1__;)
+		{
+			if (sa[i] != TEXT_INDEX_EMPTY) sa[--j] = sa[i];
+		}
+
+		// sort the LMS suffixes, recursively if two of the substrings have the same name
+		uint32_t* s1__ = sa + n - n1__;
+		if (name__ < n1__) _sais(s1__, sa, n1__, name__);
+		else
+		{
+			for (uint32_t i = 0; i != n1__; i++) sa[s1__[i]] = i;
+		}
+
+		// induce the whole suffix array from the sorted LMS suffixes
+		for (uint32_t i = 1, j = 0; i != n; i++)
+		{
+			if (is_lms__(i)) s1__[j++] = i;
+		}
+		for (uint32_t i = 0; i != n1__; i++) sa[i] = s1__[sa[i]];
+		for (uint32_t i = n1__; i != n; i++) sa[i] = TEXT_INDEX_EMPTY;
+		_sais_buckets(s, n, k, bucket__, true);
+		for (uint32_t i = n1__; i-- > 0;)
+		{
+			const uint32_t pos__ = sa[i];
+			sa[i] = TEXT_INDEX_EMPTY;
+			sa[--bucket__[s[pos__]]] = pos__;
+		}
+		_sais_induce(s, type__, sa, n, k, bucket__);
+		delete[] bucket__;
+		delete[] type__;
+	}
+
+	// a compressed full-text index (FM-index) of a static text,
+	// it answers substring queries without keeping the text
+	class text_index
+	{
+	public:
+
+		/**
+		 * brief: default constructor, an index of the empty text
+		 * param: (void)
+		 * return: --
+		 */
+		text_index();
+
+		/**
+		 * brief: constructor, build the index of a text
+		 * param: the text
+		 * return: --
+		 */
+		explicit text_index(const string& text);
+
+		/**
+		 * brief: constructor, build the index of a char array
+		 * param: the chars and the number of chars (less than 4294967295)
+		 * return: --
+		 */
+		text_index(const char* text, size_t length);
+
+		text_index(const text_index&) = delete;
+		text_index& operator=(const text_index&) = delete;
+
+		/**
+		 * brief: destructor
+		 * param: (void)
+		 * return: --
+		 */
+		~text_index();
+
+		/**
+		 * brief: rebuild the index of a char array
+		 * param: the chars and the number of chars (less than 4294967295)
+		 * return: void
+		 */
+		void build(const char* text, size_t length);
+
+		/**
+		 * brief: the length of the indexed text
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: count the occurrences of a pattern (overlapping ones included) in O(|pattern|)
+		 * param: the pattern
+		 * return: size_t (0 for the empty pattern)
+		 */
+		size_t count(const string& pattern) const noexcept;
+
+		/**
+		 * brief: count the occurrences of a pattern in O(|pattern|)
+		 * param: the pattern and its length
+		 * return: size_t (0 for the empty pattern)
+		 */
+		size_t count(const char* pattern, size_t length) const noexcept;
+
+		/**
+		 * brief: the positions of all occurrences of a pattern,
+		 *        each one is found in at most TEXT_INDEX_SA_RATE steps
+		 * param: the pattern
+		 * return: vector<size_t> (in ascending order)
+		 */
+		vector<size_t> locate(const string& pattern) const;
+
+		/**
+		 * brief: the positions of all occurrences of a pattern
+		 * param: the pattern and its length
+		 * return: vector<size_t> (in ascending order)
+		 */
+		vector<size_t> locate(const char* pattern, size_t length) const;
+
+		/**
+		 * brief: check if a pattern is in the text
+		 * param: the pattern
+		 * return: bool
+		 */
+		bool contains(const string& pattern) const noexcept;
+
+		/**
+		 * brief: save the index to a file (in the byte order of this machine)
+		 * param: the file name / an opened binary file
+		 * return: bool (false if it cannot be written)
+		 */
+		bool save(const string& file_name) const;
+		bool save(std::FILE* file) const;
+
+		/**
+		 * brief: load an index saved by function save
+		 * param: the file name / an opened binary file
+		 * return: bool (false if it cannot be read or is not a saved index, and the index is then empty)
+		 */
+		bool load(const string& file_name);
+		bool load(std::FILE* file);
+
+	private:
+
+		/**
+		 * brief: the number of a char in the rows before a certain one of the BWT
+		 * param: the char and the row
+		 * return: uint32_t
+		 */
+		uint32_t _occ(unsigned char ch, uint32_t row) const noexcept;
+
+		/**
+		 * brief: the rows of the suffixes beginning with a pattern, by backward search
+		 * param: the pattern, its length and the range [first, last) of rows
+		 * return: void
+		 */
+		void _range(const char* pattern, size_t length, uint32_t& first, uint32_t& last) const noexcept;
+
+		/**
+		 * brief: the position in the text of the suffix in a certain row
+		 * param: the row
+		 * return: size_t
+		 */
+		size_t _position(uint32_t row) const noexcept;
+
+		/**
+		 * brief: the sizes of the arrays for a certain number of rows
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t _checkpoint_count() const noexcept;
+		size_t _mark_word_count() const noexcept;
+
+		/**
+		 * brief: check the tables read by load against the BWT (the sentinel in row primary_,
+		 *        the columns, the first rows, the checkpoints, the marks and the samples),
+		 *        and that the LF mapping walks through all rows, so locate always ends
+		 * param: (void)
+		 * return: bool
+		 */
+		bool _valid() const noexcept;
+
+		/**
+		 * brief: allocate the arrays after rows_, sigma_ and sample_count_ are known
+		 * param: (void)
+		 * return: void
+		 */
+		void _allocate();
+
+		/**
+		 * brief: free the arrays and become the index of the empty text
+		 * param: (void)
+		 * return: void
+		 */
+		void _release() noexcept;
+
+		// the number of rows (the length of the text plus the sentinel)
+		uint32_t rows_ = 1;
+
+		// the row of the whole text, whose BWT char is the sentinel
+		uint32_t primary_ = 0;
+
+		// the number of distinct chars and the column of each char in the checkpoints (0xFFFF if not in the text)
+		uint32_t sigma_ = 0;
+		uint16_t column_[256];
+
+		// the first row of the suffixes beginning with each char
+		uint32_t first_row_[256];
+
+		// the BWT (the sentinel is stored as 0 in row primary_ and not counted)
+		unsigned char* bwt_ = nullptr;
+
+		// occurrences of each char before every TEXT_INDEX_OCC_RATE-th row
+		uint32_t* occ_ = nullptr;
+
+		// which rows are sampled and the number of sampled rows before each 64-bit word
+		uint64_t* marks_ = nullptr;
+		uint32_t* mark_ranks_ = nullptr;
+
+		// the text positions of the sampled rows
+		uint32_t sample_count_ = 0;
+		uint32_t* samples_ = nullptr;
+	};
+
+	inline text_index::text_index()
+	{
+		build(nullptr, 0);
+	}
+
+	inline text_index::text_index(const string& text)
+	{
+		build(text.data(), text.size());
+	}
+
+	inline text_index::text_index(const char* text, size_t length)
+	{
+		build(text, length);
+	}
+
+	inline text_index::~text_index()
+	{
+		_release();
+	}
+
+	inline void text_index::build(const char* text, size_t length)
+	{
+#ifndef NDEBUG
+		if (length >= TEXT_INDEX_EMPTY - 1) error_info("Text too long in build of tvj::text_index", TVJ_STRING_OVERFLOW);
+#endif
+		_release();
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+		rows_ = static_cast<uint32_t>(length + 1);
+
+		// the suffix array of the text followed by the sentinel 0 (chars are shifted by 1)
+		uint32_t* s__ = new uint32_t[rows_];
+		for (uint32_t i = 0; i != rows_ - 1; i++) s__[i] = p[i] + 1u;
+		s__[rows_ - 1] = 0;
+		uint32_t* sa__ = new uint32_t[rows_];
+		_sais(s__, sa__, rows_, 257);
+		delete[] s__;
+
+		uint32_t counts__[256] = { 0 };
+		for (uint32_t i = 0; i != rows_ - 1; i++) counts__[p[i]]++;
+		sigma_ = 0;
+		uint32_t sum__ = 1; // the sentinel is the first row
+		for (unsigned c = 0; c != 256; c++)
+		{
+			column_[c] = counts__[c] ? static_cast<uint16_t>(sigma_++) : 0xFFFF;
+			first_row_[c] = sum__;
+			sum__ += counts__[c];
+		}
+		sample_count_ = 0;
+		for (uint32_t i = 0; i != rows_; i++)
+		{
+			if (sa__[i] % TEXT_INDEX_SA_RATE == 0) sample_count_++;
+		}
+		_allocate();
+
+		uint32_t running__[256] = { 0 };
+		auto checkpoint__ = [this, &running__](uint32_t row)
+		{
+			uint32_t* counts__ = occ_ + static_cast<size_t>(row / TEXT_INDEX_OCC_RATE) * sigma_;
+			for (unsigned c = 0; c != 256; c++)
+			{
+				if (column_[c] != 0xFFFF) counts__[column_[c]] = running__[c];
+			}
+		};
+		uint32_t sampled__ = 0;
+		for (uint32_t i = 0; i != rows_; i++)
+		{
+			if (i % TEXT_INDEX_OCC_RATE == 0) checkpoint__(i);
+			if (i % 64 == 0) mark_ranks_[i / 64] = sampled__;
+			if (sa__[i] == 0)
+			{
+				primary_ = i;
+				bwt_[i] = 0;
+			}
+			else
+			{
+				bwt_[i] = p[sa__[i] - 1];
+				running__[bwt_[i]]++;
+			}
+			if (sa__[i] % TEXT_INDEX_SA_RATE == 0)
+			{
+				marks_[i / 64] |= 1ull << (i % 64);
+				samples_[sampled__++] = sa__[i];
+			}
+		}
+		if (rows_ % TEXT_INDEX_OCC_RATE == 0) checkpoint__(rows_); // for the queries of the row one past the last
+		delete[] sa__;
+	}
+
+	inline size_t text_index::size() const noexcept
+	{
+		return rows_ - 1;
+	}
+
+	inline size_t text_index::count(const string& pattern) const noexcept
+	{
+		return count(pattern.data(), pattern.size());
+	}
+
+	inline size_t text_index::count(const char* pattern, size_t length) const noexcept
+	{
+		uint32_t first__, last__;
+		_range(pattern, length, first__, last__);
+		return last__ - first__;
+	}
+
+	inline vector<size_t> text_index::locate(const string& pattern) const
+	{
+		return locate(pattern.data(), pattern.size());
+	}
+
+	inline vector<size_t> text_index::locate(const char* pattern, size_t length) const
+	{
+		uint32_t first__, last__;
+		_range(pattern, length, first__, last__);
+		vector<size_t> ret;
+		for (uint32_t row = first__; row != last__; row++)
+		{
+			ret.push_back(_position(row));
+		}
+		if (!ret.empty()) ret.sort();
+		return ret;
+	}
+
+	inline bool text_index::contains(const string& pattern) const noexcept
+	{
+		return count(pattern) != 0;
+	}
+
+	inline bool text_index::save(const string& file_name) const
+	{
+		std::FILE* file__ = nullptr;
+#ifdef _MSC_VER
+		fopen_s(&file__, file_name.c_str(), "wb");
+#else
+		file__ = std::fopen(file_name.c_str(), "wb");
+#endif
+		if (!file__) return false;
+		const bool ret = save(file__);
+		return std::fclose(file__) == 0 && ret;
+	}
+
+	inline bool text_index::save(std::FILE* file) const
+	{
+		const uint32_t header__[6] = { 0x4A565420u /* "TVJ " */, 0x31494D46u /* "FMI1" */,
+			TEXT_INDEX_OCC_RATE, TEXT_INDEX_SA_RATE, rows_, primary_ };
+		return std::fwrite(header__, sizeof(uint32_t), 6, file) == 6
+			&& std::fwrite(&sigma_, sizeof(uint32_t), 1, file) == 1
+			&& std::fwrite(&sample_count_, sizeof(uint32_t), 1, file) == 1
+			&& std::fwrite(column_, sizeof(uint16_t), 256, file) == 256
+			&& std::fwrite(first_row_, sizeof(uint32_t), 256, file) == 256
+			&& std::fwrite(bwt_, 1, rows_, file) == rows_
+			&& std::fwrite(occ_, sizeof(uint32_t), _checkpoint_count() * sigma_, file) == _checkpoint_count() * sigma_
+			&& std::fwrite(marks_, sizeof(uint64_t), _mark_word_count(), file) == _mark_word_count()
+			&& std::fwrite(mark_ranks_, sizeof(uint32_t), _mark_word_count(), file) == _mark_word_count()
+			&& std::fwrite(samples_, sizeof(uint32_t), sample_count_, file) == sample_count_;
+	}
+
+	inline bool text_index::load(const string& file_name)
+	{
+		std::FILE* file__ = nullptr;
+#ifdef _MSC_VER
+		fopen_s(&file__, file_name.c_str(), "rb");
+#else
+		file__ = std::fopen(file_name.c_str(), "rb");
+#endif
+		if (!file__)
+		{
+			build(nullptr, 0);
+			return false;
+		}
+		const bool ret = load(file__);
+		std::fclose(file__);
+		return ret;
+	}
+
+	inline bool text_index::load(std::FILE* file)
+	{
+		_release();
+		uint32_t header__[6];
+		bool ok__ = std::fread(header__, sizeof(uint32_t), 6, file) == 6
+			&& header__[0] == 0x4A565420u && header__[1] == 0x31494D46u
+			&& header__[2] == TEXT_INDEX_OCC_RATE && header__[3] == TEXT_INDEX_SA_RATE
+			&& header__[4] != 0 && header__[4] != TEXT_INDEX_EMPTY && header__[5] < header__[4]
+			&& std::fread(&sigma_, sizeof(uint32_t), 1, file) == 1 && sigma_ <= 256
+			&& std::fread(&sample_count_, sizeof(uint32_t), 1, file) == 1 && sample_count_ <= header__[4];
+		if (ok__)
+		{
+			rows_ = header__[4];
+			primary_ = header__[5];
+			_allocate();
+			ok__ = std::fread(column_, sizeof(uint16_t), 256, file) == 256
+				&& std::fread(first_row_, sizeof(uint32_t), 256, file) == 256
+				&& std::fread(bwt_, 1, rows_, file) == rows_
+				&& std::fread(occ_, sizeof(uint32_t), _checkpoint_count() * sigma_, file) == _checkpoint_count() * sigma_
+				&& std::fread(marks_, sizeof(uint64_t), _mark_word_count(), file) == _mark_word_count()
+				&& std::fread(mark_ranks_, sizeof(uint32_t), _mark_word_count(), file) == _mark_word_count()
+				&& std::fread(samples_, sizeof(uint32_t), sample_count_, file) == sample_count_
+				&& _valid();
+		}
+		if (!ok__) build(nullptr, 0);
+		return ok__;
+	}
+
+	inline uint32_t text_index::_occ(unsigned char ch, uint32_t row) const noexcept
+	{
+		const uint32_t block__ = row / TEXT_INDEX_OCC_RATE;
+		const uint32_t start__ = block__ * TEXT_INDEX_OCC_RATE;
+		uint32_t ret = occ_[static_cast<size_t>(block__) * sigma_ + column_[ch]]
+			+ static_cast<uint32_t>(_index_count_byte(bwt_ + start__, row - start__, ch));
+		if (ch == 0 && start__ <= primary_ && primary_ < row) ret--; // the sentinel
+		return ret;
+	}
+
+	inline void text_index::_range(const char* pattern, size_t length, uint32_t& first, uint32_t& last) const noexcept
+	{
+		first = last = 0;
+		if (length == 0) return;
+		first = 0;
+		last = rows_;
+		for (size_t i = length; i-- > 0;)
+		{
+			const unsigned char ch = static_cast<unsigned char>(pattern[i]);
+			if (column_[ch] == 0xFFFF)
+			{
+				first = last = 0;
+				return;
+			}
+			first = first_row_[ch] + _occ(ch, first);
+			last = first_row_[ch] + _occ(ch, last);
+			if (first >= last)
+			{
+				first = last = 0;
+				return;
+			}
+		}
+	}
+
+	inline size_t text_index::_position(uint32_t row) const noexcept
+	{
+		size_t steps__ = 0;
+		while (!((marks_[row / 64] >> (row % 64)) & 1))
+		{
+			// LF mapping: the row of the suffix one char earlier in the text
+			const unsigned char ch = bwt_[row];
+			row = first_row_[ch] + _occ(ch, row);
+			steps__++;
+		}
+		const uint32_t rank__ = mark_ranks_[row / 64] + _index_popcount(marks_[row / 64] & ((1ull << (row % 64)) - 1));
+		return samples_[rank__] + steps__;
+	}
+
+	inline bool text_index::_valid() const noexcept
+	{
+		if (primary_ >= rows_ || bwt_[primary_] != 0) return false;
+
+		// the columns are given to the chars in the text in order, and their rows follow the sentinel
+		uint32_t counts__[256] = { 0 };
+		for (uint32_t i = 0; i != rows_; i++)
+		{
+			if (i != primary_) counts__[bwt_[i]]++;
+		}
+		uint32_t columns__ = 0, sum__ = 1;
+		for (unsigned c = 0; c != 256; c++)
+		{
+			if (column_[c] != (counts__[c] ? columns__++ : 0xFFFFu)) return false;
+			if (counts__[c] && first_row_[c] != sum__) return false;
+			sum__ += counts__[c];
+		}
+		if (columns__ != sigma_) return false;
+
+		// the checkpoints, the marks and their ranks
+		uint32_t running__[256] = { 0 };
+		uint32_t sampled__ = 0;
+		for (uint32_t i = 0; i <= rows_; i++)
+		{
+			if (i % TEXT_INDEX_OCC_RATE == 0 && (i != rows_ || rows_ % TEXT_INDEX_OCC_RATE == 0))
+			{
+				const uint32_t* checkpoint__ = occ_ + static_cast<size_t>(i / TEXT_INDEX_OCC_RATE) * sigma_;
+				for (unsigned c = 0; c != 256; c++)
+				{
+					if (column_[c] != 0xFFFF && checkpoint__[column_[c]] != running__[c]) return false;
+				}
+			}
+			if (i == rows_) break;
+			if (i % 64 == 0 && mark_ranks_[i / 64] != sampled__) return false;
+			if (i != primary_) running__[bwt_[i]]++;
+			sampled__ += (marks_[i / 64] >> (i % 64)) & 1;
+		}
+		if (rows_ % 64 && marks_[rows_ / 64] >> (rows_ % 64)) return false;
+		if (sampled__ != sample_count_) return false;
+
+		// row 0 is the suffix of the sentinel alone, and the LF mapping goes one char earlier each time
+		// through every row until the whole text in row primary_, so each sample must be the position reached
+		uint32_t row__ = 0;
+		for (uint32_t position__ = rows_ - 1; ; position__--)
+		{
+			if ((marks_[row__ / 64] >> (row__ % 64)) & 1)
+			{
+				const uint32_t rank__ = mark_ranks_[row__ / 64] + _index_popcount(marks_[row__ / 64] & ((1ull << (row__ % 64)) - 1));
+				if (samples_[rank__] != position__) return false;
+			}
+			if (row__ == primary_) return position__ == 0;
+			if (position__ == 0) return false;
+			const unsigned char ch = bwt_[row__];
+			row__ = first_row_[ch] + _occ(ch, row__);
+		}
+	}
+
+	inline size_t text_index::_checkpoint_count() const noexcept
+	{
+		return rows_ / TEXT_INDEX_OCC_RATE + 1;
+	}
+
+	inline size_t text_index::_mark_word_count() const noexcept
+	{
+		return (static_cast<size_t>(rows_) + 63) / 64;
+	}
+
+	inline void text_index::_allocate()
+	{
+		bwt_ = new unsigned char[rows_];
+		occ_ = new uint32_t[_checkpoint_count() * sigma_ + 1];
+		marks_ = new uint64_t[_mark_word_count()];
+		for (size_t i = 0; i != _mark_word_count(); i++) marks_[i] = 0;
+		mark_ranks_ = new uint32_t[_mark_word_count()];
+		samples_ = new uint32_t[sample_count_ + 1];
+	}
+
+	inline void text_index::_release() noexcept
+	{
+		delete[] bwt_;
+		delete[] occ_;
+		delete[] marks_;
+		delete[] mark_ranks_;
+		delete[] samples_;
+		bwt_ = nullptr;
+		occ_ = nullptr;
+		marks_ = nullptr;
+		mark_ranks_ = nullptr;
+		samples_ = nullptr;
+		rows_ = 1;
+		primary_ = 0;
+		sigma_ = 0;
+		sample_count_ = 0;
+		for (unsigned c = 0; c != 256; c++)
+		{
+			column_[c] = 0xFFFF;
+			first_row_[c] = 1;
+		}
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
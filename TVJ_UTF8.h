@@ -0,0 +1,455 @@
+/*
+ * File: TVJ_UTF8.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TVJ_UTF8_SSE2
+#endif
+#if defined(__SSSE3__) || (defined(_MSC_VER) && defined(__AVX__))
+#include <tmmintrin.h>
+#define TVJ_UTF8_SSSE3
+#endif
+#ifdef _MSC_VER
+#include <intrin.h> // __popcnt
+#endif
+
+namespace tvj
+{
+#define TVJ_UTF8_REPLACEMENT 0xFFFD // the code point given for malformed bytes
+
+	/**
+	 * brief: the number of set bits
+	 * param: unsigned
+	 * return: unsigned
+	 */
+	inline unsigned _utf8_popcount(unsigned mask) noexcept
+	{
+#ifdef _MSC_VER
+		return __popcnt(mask);
+#else
+		return static_cast<unsigned>(__builtin_popcount(mask));
+#endif
+	}
+
+	/**
+	 * brief: the length of a well-formed sequence at a certain position
+	 * param: the bytes, the number of bytes left
+	 * return: 1 to 4, 0 if the sequence is malformed
+	 */
+	inline unsigned _utf8_sequence_length(const unsigned char* p, size_t left) noexcept
+	{
+		const unsigned char c = p[0];
+		if (c < 0x80) return 1;
+		if (c < 0xC2) return 0; // a continuation byte or an overlong lead
+		if (c < 0xE0)
+		{
+			return left >= 2 && (p[1] & 0xC0) == 0x80 ? 2 : 0;
+		}
+		if (c < 0xF0)
+		{
+			if (left < 3 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80) return 0;
+			if (c == 0xE0 && p[1] < 0xA0) return 0; // overlong
+			if (c == 0xED && p[1] >= 0xA0) return 0; // surrogate
+			return 3;
+		}
+		if (c < 0xF5)
+		{
+			if (left < 4 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80) return 0;
+			if (c == 0xF0 && p[1] < 0x90) return 0; // overlong
+			if (c == 0xF4 && p[1] >= 0x90) return 0; // larger than U+10FFFF
+			return 4;
+		}
+		return 0;
+	}
+
+	/**
+	 * brief: validate byte by byte, ASCII is skipped 8 bytes at a time
+	 * param: the bytes and the number of bytes
+	 * return: bool
+	 */
+	inline bool _utf8_validate_scalar(const unsigned char* p, size_t length) noexcept
+	{
+		size_t i = 0;
+		while (i != length)
+		{
+			if (length - i >= 8)
+			{
+				uint64_t block__;
+				memcpy(&block__, p + i, 8);
+				if (!(block__ & 0x8080808080808080ull))
+				{
+					i += 8;
+					continue;
+				}
+			}
+			const unsigned sequence__ = _utf8_sequence_length(p + i, length - i);
+			if (!sequence__) return false;
+			i += sequence__;
+		}
+		return true;
+	}
+
+#ifdef TVJ_UTF8_SSSE3
+
+	// the state of the vectorized validation carried from one 16-byte block to the next
+	// (the lookup algorithm of John Keiser and Daniel Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte")
+	struct _utf8_checker
+	{
+		__m128i error_ = _mm_setzero_si128();
+		__m128i prev_input_ = _mm_setzero_si128();
+		__m128i prev_incomplete_ = _mm_setzero_si128();
+
+		/**
+		 * brief: check a 16-byte block
+		 * param: the block
+		 * return: void
+		 */
+		void check(__m128i input) noexcept
+		{
+			if (!_mm_movemask_epi8(input)) // ASCII only
+			{
+				error_ = _mm_or_si128(error_, prev_incomplete_);
+				prev_incomplete_ = _mm_setzero_si128();
+				prev_input_ = input;
+				return;
+			}
+			const unsigned char TOO_SHORT = 1 << 0, TOO_LONG = 1 << 1, OVERLONG_3 = 1 << 2, TOO_LARGE = 1 << 3,
+				SURROGATE = 1 << 4, OVERLONG_2 = 1 << 5, TOO_LARGE_1000 = 1 << 6, OVERLONG_4 = 1 << 6,
+				TWO_CONTS = 1 << 7, CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+			const __m128i low_nibble__ = _mm_set1_epi8(0x0F);
+			const __m128i prev1__ = _mm_alignr_epi8(input, prev_input_, 15);
+			const __m128i byte_1_high__ = _mm_shuffle_epi8(_mm_setr_epi8(
+				TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+				TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+				TOO_SHORT | OVERLONG_2,
+				TOO_SHORT,
+				TOO_SHORT | OVERLONG_3 | SURROGATE,
+				TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4),
+				_mm_and_si128(_mm_srli_epi16(prev1__, 4), low_nibble__));
+			const char LARGE__ = CARRY | TOO_LARGE | TOO_LARGE_1000;
+			const __m128i byte_1_low__ = _mm_shuffle_epi8(_mm_setr_epi8(
+				CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+				CARRY | OVERLONG_2,
+				CARRY, CARRY,
+				CARRY | TOO_LARGE,
+				LARGE__, LARGE__, LARGE__, LARGE__, LARGE__, LARGE__, LARGE__, LARGE__,
+				LARGE__ | SURROGATE,
+				LARGE__, LARGE__),
+				_mm_and_si128(prev1__, low_nibble__));
+			const char CONT__ = TOO_LONG | OVERLONG_2 | TWO_CONTS;
+			const __m128i byte_2_high__ = _mm_shuffle_epi8(_mm_setr_epi8(
+				TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+				CONT__ | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+				CONT__ | OVERLONG_3 | TOO_LARGE,
+				CONT__ | SURROGATE | TOO_LARGE,
+				CONT__ | SURROGATE | TOO_LARGE,
+				TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT),
+				_mm_and_si128(_mm_srli_epi16(input, 4), low_nibble__));
+			const __m128i special_cases__ = _mm_and_si128(_mm_and_si128(byte_1_high__, byte_1_low__), byte_2_high__);
+
+			// the second and third continuation bytes of 3- and 4-byte sequences
+			const __m128i prev2__ = _mm_alignr_epi8(input, prev_input_, 14);
+			const __m128i prev3__ = _mm_alignr_epi8(input, prev_input_, 13);
+			const __m128i is_third_byte__ = _mm_subs_epu8(prev2__, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+			const __m128i is_fourth_byte__ = _mm_subs_epu8(prev3__, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+			const __m128i must_23_80__ = _mm_and_si128(_mm_or_si128(is_third_byte__, is_fourth_byte__), _mm_set1_epi8(static_cast<char>(0x80)));
+			error_ = _mm_or_si128(error_, _mm_xor_si128(must_23_80__, special_cases__));
+
+			// a sequence cut at the end of the block
+			prev_incomplete_ = _mm_subs_epu8(input, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)));
+			prev_input_ = input;
+		}
+
+		/**
+		 * brief: whether no error has been found (including a sequence cut at the end)
+		 * param: (void)
+		 * return: bool
+		 */
+		bool valid() const noexcept
+		{
+			const __m128i error__ = _mm_or_si128(error_, prev_incomplete_);
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(error__, _mm_setzero_si128())) == 0xFFFF;
+		}
+	};
+
+#endif
+
+	/**
+	 * brief: check if a char array is well-formed UTF-8
+	 *        (16 bytes at a time with SSSE3, ASCII skipped 16 bytes at a time with SSE2)
+	 * param: the char array and its length
+	 * return: bool
+	 */
+	inline bool utf8_validate(const char* text, size_t length) noexcept
+	{
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+#if defined(TVJ_UTF8_SSSE3)
+		_utf8_checker checker__;
+		size_t i = 0;
+		for (; i + 16 <= length; i += 16)
+		{
+			checker__.check(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+		}
+		if (i != length)
+		{
+			unsigned char tail__[16] = { 0 }; // padded with ASCII
+			memcpy(tail__, p + i, length - i);
+			checker__.check(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tail__)));
+		}
+		return checker__.valid();
+#elif defined(TVJ_UTF8_SSE2)
+		size_t i = 0;
+		while (i != length)
+		{
+			if (length - i >= 16 && !_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i))))
+			{
+				i += 16;
+				continue;
+			}
+			const unsigned sequence__ = _utf8_sequence_length(p + i, length - i);
+			if (!sequence__) return false;
+			i += sequence__;
+		}
+		return true;
+#else
+		return _utf8_validate_scalar(p, length);
+#endif
+	}
+
+	/**
+	 * brief: the number of code points (the number of bytes that are not continuation bytes),
+	 *        the text is expected to be well-formed
+	 * param: the char array and its length
+	 * return: size_t
+	 */
+	inline size_t utf8_count(const char* text, size_t length) noexcept
+	{
+		size_t count__ = 0;
+		size_t i = 0;
+#ifdef TVJ_UTF8_SSE2
+		const __m128i continuation__ = _mm_set1_epi8(static_cast<char>(0xBF)); // 0x80 to 0xBF are the smallest as signed
+		for (; i + 16 <= length; i += 16)
+		{
+			const __m128i block__ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+			count__ += _utf8_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(block__, continuation__))));
+		}
+#endif
+		for (; i != length; i++)
+		{
+			if ((static_cast<unsigned char>(text[i]) & 0xC0) != 0x80) count__++;
+		}
+		return count__;
+	}
+
+	/**
+	 * brief: decode one code point and move the position past it,
+	 *        a malformed sequence gives TVJ_UTF8_REPLACEMENT and moves by one byte
+	 * param: the char array, its length and the position (less than the length)
+	 * return: char32_t
+	 */
+	inline char32_t utf8_decode(const char* text, size_t length, size_t& pos) noexcept
+	{
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(text) + pos;
+		switch (_utf8_sequence_length(p, length - pos))
+		{
+		case 1:
+			pos += 1;
+			return p[0];
+		case 2:
+			pos += 2;
+			return (static_cast<char32_t>(p[0] & 0x1F) << 6) | (p[1] & 0x3F);
+		case 3:
+			pos += 3;
+			return (static_cast<char32_t>(p[0] & 0x0F) << 12) | (static_cast<char32_t>(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+		case 4:
+			pos += 4;
+			return (static_cast<char32_t>(p[0] & 0x07) << 18) | (static_cast<char32_t>(p[1] & 0x3F) << 12)
+				| (static_cast<char32_t>(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+		default:
+			pos += 1;
+			return TVJ_UTF8_REPLACEMENT;
+		}
+	}
+
+	/**
+	 * brief: encode one code point, surrogates and values above U+10FFFF give TVJ_UTF8_REPLACEMENT
+	 * param: the code point and where to write (at least 4 chars)
+	 * return: the number of chars written (1 to 4)
+	 */
+	inline unsigned utf8_encode(char32_t code_point, char* out) noexcept
+	{
+		if (code_point < 0x80)
+		{
+			out[0] = static_cast<char>(code_point);
+			return 1;
+		}
+		if (code_point < 0x800)
+		{
+			out[0] = static_cast<char>(0xC0 | (code_point >> 6));
+			out[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+			return 2;
+		}
+		if (code_point > 0x10FFFF || (code_point >= 0xD800 && code_point < 0xE000)) code_point = TVJ_UTF8_REPLACEMENT;
+		if (code_point < 0x10000)
+		{
+			out[0] = static_cast<char>(0xE0 | (code_point >> 12));
+			out[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+			out[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+			return 3;
+		}
+		out[0] = static_cast<char>(0xF0 | (code_point >> 18));
+		out[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+		out[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+		out[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+		return 4;
+	}
+
+	/**
+	 * brief: transcode to UTF-32 (ASCII is widened 16 bytes at a time with SSE2),
+	 *        malformed sequences give TVJ_UTF8_REPLACEMENT
+	 * param: the char array, its length and where to write (at least length code points)
+	 * return: the number of code points written
+	 */
+	inline size_t utf8_to_utf32(const char* text, size_t length, char32_t* out) noexcept
+	{
+		size_t written__ = 0;
+		size_t i = 0;
+		while (i != length)
+		{
+#ifdef TVJ_UTF8_SSE2
+			if (length - i >= 16)
+			{
+				const __m128i block__ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+				if (!_mm_movemask_epi8(block__))
+				{
+					const __m128i zero__ = _mm_setzero_si128();
+					const __m128i low__ = _mm_unpacklo_epi8(block__, zero__);
+					const __m128i high__ = _mm_unpackhi_epi8(block__, zero__);
+					__m128i* target__ = reinterpret_cast<__m128i*>(out + written__);
+					_mm_storeu_si128(target__, _mm_unpacklo_epi16(low__, zero__));
+					_mm_storeu_si128(target__ + 1, _mm_unpackhi_epi16(low__, zero__));
+					_mm_storeu_si128(target__ + 2, _mm_unpacklo_epi16(high__, zero__));
+					_mm_storeu_si128(target__ + 3, _mm_unpackhi_epi16(high__, zero__));
+					written__ += 16;
+					i += 16;
+					continue;
+				}
+			}
+#endif
+			out[written__++] = utf8_decode(text, length, i);
+		}
+		return written__;
+	}
+
+	// the code points of a UTF-8 char array (the array is not copied)
+	class utf8_view
+	{
+	public:
+
+		// the iterator that decodes one code point at a time
+		class const_iterator
+		{
+		public:
+			const_iterator(const char* text, size_t length, size_t pos) noexcept;
+			char32_t operator*() const noexcept;
+			const_iterator& operator++() noexcept;
+			const_iterator operator++(int) noexcept;
+			bool operator==(const const_iterator& iter) const noexcept;
+			bool operator!=(const const_iterator& iter) const noexcept;
+
+			/**
+			 * brief: the byte offset of the current code point
+			 * param: (void)
+			 * return: size_t
+			 */
+			size_t offset() const noexcept;
+
+		private:
+			const char* text_;
+			size_t length_;
+			size_t pos_;
+		};
+
+		/**
+		 * brief: constructor
+		 * param: the char array and its length
+		 * return: --
+		 */
+		utf8_view(const char* text, size_t length) noexcept;
+
+		const_iterator begin() const noexcept;
+		const_iterator end() const noexcept;
+
+	private:
+		const char* text_;
+		size_t length_;
+	};
+
+	inline utf8_view::const_iterator::const_iterator(const char* text, size_t length, size_t pos) noexcept
+		: text_(text), length_(length), pos_(pos) { }
+
+	inline char32_t utf8_view::const_iterator::operator*() const noexcept
+	{
+		size_t pos__ = pos_;
+		return utf8_decode(text_, length_, pos__);
+	}
+
+	inline utf8_view::const_iterator& utf8_view::const_iterator::operator++() noexcept
+	{
+		const unsigned sequence__ = _utf8_sequence_length(reinterpret_cast<const unsigned char*>(text_) + pos_, length_ - pos_);
+		pos_ += sequence__ ? sequence__ : 1;
+		return *this;
+	}
+
+	inline utf8_view::const_iterator utf8_view::const_iterator::operator++(int) noexcept
+	{
+		const_iterator ret = *this;
+		++*this;
+		return ret;
+	}
+
+	inline bool utf8_view::const_iterator::operator==(const const_iterator& iter) const noexcept
+	{
+		return pos_ == iter.pos_;
+	}
+
+	inline bool utf8_view::const_iterator::operator!=(const const_iterator& iter) const noexcept
+	{
+		return pos_ != iter.pos_;
+	}
+
+	inline size_t utf8_view::const_iterator::offset() const noexcept
+	{
+		return pos_;
+	}
+
+	inline utf8_view::utf8_view(const char* text, size_t length) noexcept : text_(text), length_(length) { }
+
+	inline utf8_view::const_iterator utf8_view::begin() const noexcept
+	{
+		return const_iterator(text_, length_, 0);
+	}
+
+	inline utf8_view::const_iterator utf8_view::end() const noexcept
+	{
+		return const_iterator(text_, length_, length_);
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
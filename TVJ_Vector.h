@@ -6,6 +6,23 @@
  * @licence: The MIT Licence
  * @compiler: at least C++/11 (tested on MSVC and MinGW)
  *
+ * @version 1.8 2026/10/18
+ * - bug fix: push_back, push_front and insert_after of an element of the vector itself
+ *   read it after the array grew (or its elements shifted)
+ * 
+ * @version 1.7 2026/10/18
+ * - add push_back with an rvalue (moved in)
+ * - elements are moved instead of copied when the array grows
+ * 
+ * @version 1.6 2026/10/18
+ * - add functions _reserve and _adopt
+ * - bug fix: _move reads out of range when moving right by more than one
+ * 
+ * @version 1.5 2026/10/18
+ * - add function _data
+ * - bug fix: operator= copies the contents instead of sharing the dynamic array
+ * - bug fix: capacity_ in the constructor with size
+ * 
  * @version 1.4 2021/05/14
  * - add function no_delete
  * 
@@ -31,6 +48,7 @@
 #include <stdexcept>
 #include <exception>
 #include <iterator>
+#include <utility>
 #ifdef _MSC_VER
 #include <xutility> // std::_Is_iterator
 #endif // for MSVC
@@ -303,6 +321,13 @@ _error_info(_text__, _exception__, __FILE__, __LINE__);
          */
         void push_back(const Elem& value) noexcept;
 
+        /**
+         * brief: push element at the back (moved in)
+         * param: the element
+         * return: void
+         */
+        void push_back(Elem&& value) noexcept;
+
         /**
          * brief: push element at the front
          * param: the element
@@ -443,6 +468,13 @@ _error_info(_text__, _exception__, __FILE__, __LINE__);
          */
         bool operator!=(const vector<Elem>& vec) const noexcept;
 
+        /**
+         * brief: copy (the contents are copied instead of sharing the dynamic array)
+         * param: another vector the same element type
+         * return: the copied vector (read & write)
+         */
+        vector<Elem>& operator=(const vector<Elem>& vec);
+
         /**
          * ================== CAUTION ==================
          * This function should be used very carefully!
@@ -472,6 +504,28 @@ _error_info(_text__, _exception__, __FILE__, __LINE__);
          */
         void _expand();
 
+        /**
+         * brief: the underlying dynamic array (invalidated by the next reallocation)
+         * param: (void)
+         * return: Elem*
+         */
+        Elem* _data() const noexcept;
+
+        /**
+         * brief: make sure the capacity is at least a certain number,
+         *        grow by doubling so that repeated calls are amortized constant
+         * param: the least capacity
+         * return: void
+         */
+        void _reserve(size_t capacity);
+
+        /**
+         * brief: take over a dynamic array (allocated by new[]) instead of the current one
+         * param: the array, the number of valid elements and the size of the array
+         * return: void
+         */
+        void _adopt(Elem* data, size_t size, size_t capacity) noexcept;
+
         /**
          * brief: move elements from a certain index by a distance
          * param: the start index and the distance (right as positive)
@@ -847,6 +901,7 @@ _error_info(_text__, _exception__, __FILE__, __LINE__);
     {
         if (capacity < 2) capacity = 2;
         while (capacity <= size) capacity <<= 1; // twice its size
+        capacity_ = capacity;
         vec = new Elem[capacity];
         for (int i = 0; i != capacity; i++) vec[i] = elem;
     }
@@ -868,16 +923,36 @@ _error_info(_text__, _exception__, __FILE__, __LINE__);
     template<typename Elem>
     inline void vector<Elem>::push_back(const Elem& value) noexcept
     {
-        if (size_ + 1 == capacity_) _expand();
-        vec[size_++] = value;
+        if (size_ + 1 == capacity_)
+        {
+            // value may be an element of this vector, which _expand moves away and frees
+            Elem copy__(value);
+            _expand();
+            vec[size_++] = std::move(copy__);
+        }
+        else vec[size_++] = value;
+    }
+
+    template<typename Elem>
+    inline void vector<Elem>::push_back(Elem&& value) noexcept
+    {
+        if (size_ + 1 == capacity_)
+        {
+            Elem moved__(std::move(value));
+            _expand();
+            vec[size_++] = std::move(moved__);
+        }
+        else vec[size_++] = std::move(value);
     }
 
     template<typename Elem>
     inline void vector<Elem>::push_front(const Elem& value) noexcept
     {
+        // value may be an element of this vector, which is shifted (or freed) below
+        Elem copy__(value);
         if (size_ + 1 == capacity_) _expand();
         _move(0);
-        vec[0] = value;
+        vec[0] = std::move(copy__);
         size_++;
     }
 
@@ -909,9 +984,10 @@ _error_info(_text__, _exception__, __FILE__, __LINE__);
 #ifndef NDEBUG
             if (index >= size_) error_info("Overflow in insert_after of tvj::vector", TVJ_VECTOR_OVERFLOW);
 #endif
+            Elem copy__(value);
             if (size_ + 1 == capacity_) _expand();
             _move(index);
-            vec[index] = value;
+            vec[index] = std::move(copy__);
         }
     }
 
@@ -1074,6 +1150,20 @@ _error_info(_text__, _exception__, __FILE__, __LINE__);
         return !(*this == another_vec);
     }
 
+    template<typename Elem>
+    inline vector<Elem>& vector<Elem>::operator=(const vector<Elem>& another_vec)
+    {
+        if (this == &another_vec) return *this;
+        Elem* new_vec = new Elem[another_vec.capacity_];
+        for (size_t i = 0; i != another_vec.size_; i++)
+            new_vec[i] = another_vec.vec[i];
+        if (vec) delete[] vec;
+        vec = new_vec;
+        capacity_ = another_vec.capacity_;
+        size_ = another_vec.size_;
+        return *this;
+    }
+
     template<typename Elem>
     inline void vector<Elem>::no_delete()
     {
@@ -1085,9 +1175,9 @@ _error_info(_text__, _exception__, __FILE__, __LINE__);
     {
         // 1. ask for new space for the array
         Elem* new_vec = new Elem[capacity_ << 1];
-        // 2. copy the values over
+        // 2. move the values over
         for (size_t i = 0; i != size_; i++)
-            new_vec[i] = vec[i];
+            new_vec[i] = std::move(vec[i]);
         // 3. delete the old array
         delete[] vec;
         // 4. point vec to new array
@@ -1096,12 +1186,41 @@ _error_info(_text__, _exception__, __FILE__, __LINE__);
         capacity_ <<= 1;
     }
 
+    template<typename Elem>
+    inline Elem* vector<Elem>::_data() const noexcept
+    {
+        return vec;
+    }
+
+    template<typename Elem>
+    inline void vector<Elem>::_reserve(size_t capacity)
+    {
+        if (capacity <= capacity_) return;
+        size_t new_capacity = capacity_ < 2 ? 2 : capacity_;
+        while (new_capacity < capacity) new_capacity <<= 1;
+        Elem* new_vec = new Elem[new_capacity];
+        for (size_t i = 0; i != size_; i++)
+            new_vec[i] = std::move(vec[i]);
+        delete[] vec;
+        vec = new_vec;
+        capacity_ = new_capacity;
+    }
+
+    template<typename Elem>
+    inline void vector<Elem>::_adopt(Elem* data, size_t size, size_t capacity) noexcept
+    {
+        if (vec) delete[] vec;
+        vec = data;
+        size_ = size;
+        capacity_ = capacity;
+    }
+
     template<typename Elem>
     inline void vector<Elem>::_move(size_t start_index, long long distance)
     {
         if (distance == 0) return;
         if (distance > 0) // move right
-            for (size_t i = size_ + distance - 1; i != start_index; i--) vec[i] = vec[i - distance];
+            for (size_t i = size_; i != start_index; i--) vec[i - 1 + distance] = vec[i - 1];
         else // move left
             for (size_t i = start_index; i != size_; i++) vec[i + distance] = vec[i];
     }
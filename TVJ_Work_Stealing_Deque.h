@@ -0,0 +1,216 @@
+/*
+ * File: TVJ_Work_Stealing_Deque.h
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/11 (tested on MSVC and MinGW)
+ *
+ * @version 1.0 2026/10/18
+ * - initial version
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+// The deque follows Chase and Lev, "Dynamic Circular Work-Stealing Deque",
+// with the memory orders of Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models".
+
+namespace tvj
+{
+#define WORK_STEALING_DEQUE_CAPACITY 64 // the initial capacity (a power of 2)
+
+	// a deque owned by one thread, which pushes and pops at the bottom like a stack,
+	// while any other thread can steal from the top,
+	// the elements should be small and trivially copyable (e.g. pointers to nodes or tasks)
+	template<typename Elem>
+	class work_stealing_deque
+	{
+	public:
+
+		/**
+		 * brief: default constructor
+		 * param: (void)
+		 * return: --
+		 */
+		work_stealing_deque();
+
+		work_stealing_deque(const work_stealing_deque&) = delete;
+		work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+		/**
+		 * brief: destructor (no other thread may be using the deque)
+		 * param: (void)
+		 * return: --
+		 */
+		~work_stealing_deque();
+
+		/**
+		 * brief: push an element at the bottom (by the owner only)
+		 * param: the element
+		 * return: void
+		 */
+		void push(const Elem& elem);
+
+		/**
+		 * brief: pop the bottom element (by the owner only)
+		 * param: where to copy the element
+		 * return: bool (false if the deque is empty or the last element is stolen)
+		 */
+		bool pop(Elem& elem);
+
+		/**
+		 * brief: steal the top element (by any thread)
+		 * param: where to copy the element
+		 * return: bool (false if the deque is empty or another thread takes the element first)
+		 */
+		bool steal(Elem& elem);
+
+		/**
+		 * brief: the number of elements (only a snapshot when other threads are working)
+		 * param: (void)
+		 * return: size_t
+		 */
+		size_t size() const noexcept;
+
+		/**
+		 * brief: check if it is empty (only a snapshot when other threads are working)
+		 * param: (void)
+		 * return: bool
+		 */
+		bool empty() const noexcept;
+
+	private:
+
+		// a circular array
+		struct _ring
+		{
+			long long capacity_;
+			std::atomic<Elem>* slots_;
+
+			// the smaller ring replaced by this one, a thief may still be reading it
+			_ring* retired_;
+
+			_ring(long long capacity, _ring* retired) : capacity_(capacity), slots_(new std::atomic<Elem>[static_cast<size_t>(capacity)]), retired_(retired) { }
+			~_ring() { delete[] slots_; }
+
+			Elem get(long long index) const noexcept
+			{
+				return slots_[index & (capacity_ - 1)].load(std::memory_order_relaxed);
+			}
+
+			void put(long long index, const Elem& elem) noexcept
+			{
+				slots_[index & (capacity_ - 1)].store(elem, std::memory_order_relaxed);
+			}
+		};
+
+		/**
+		 * brief: copy the elements into a ring twice as large
+		 * param: the current ring, the top and the bottom
+		 * return: the new ring
+		 */
+		_ring* _grow(_ring* ring, long long top, long long bottom);
+
+		std::atomic<long long> top_;
+		std::atomic<long long> bottom_;
+		std::atomic<_ring*> ring_;
+	};
+
+	template<typename Elem>
+	inline work_stealing_deque<Elem>::work_stealing_deque()
+		: top_(0), bottom_(0), ring_(new _ring(WORK_STEALING_DEQUE_CAPACITY, nullptr))
+	{
+		static_assert(std::is_trivially_copyable<Elem>::value, "tvj::work_stealing_deque needs a trivially copyable element type");
+	}
+
+	template<typename Elem>
+	inline work_stealing_deque<Elem>::~work_stealing_deque()
+	{
+		_ring* ring__ = ring_.load(std::memory_order_relaxed);
+		while (ring__)
+		{
+			_ring* retired__ = ring__->retired_;
+			delete ring__;
+			ring__ = retired__;
+		}
+	}
+
+	template<typename Elem>
+	inline void work_stealing_deque<Elem>::push(const Elem& elem)
+	{
+		const long long bottom__ = bottom_.load(std::memory_order_relaxed);
+		const long long top__ = top_.load(std::memory_order_acquire);
+		_ring* ring__ = ring_.load(std::memory_order_relaxed);
+		if (bottom__ - top__ > ring__->capacity_ - 1) ring__ = _grow(ring__, top__, bottom__);
+		ring__->put(bottom__, elem);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom_.store(bottom__ + 1, std::memory_order_relaxed);
+	}
+
+	template<typename Elem>
+	inline bool work_stealing_deque<Elem>::pop(Elem& elem)
+	{
+		const long long bottom__ = bottom_.load(std::memory_order_relaxed) - 1;
+		_ring* ring__ = ring_.load(std::memory_order_relaxed);
+		bottom_.store(bottom__, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		long long top__ = top_.load(std::memory_order_relaxed);
+		if (top__ > bottom__) // empty
+		{
+			bottom_.store(bottom__ + 1, std::memory_order_relaxed);
+			return false;
+		}
+		elem = ring__->get(bottom__);
+		if (top__ == bottom__)
+		{
+			// the last element, race against the thieves for it
+			const bool won__ = top_.compare_exchange_strong(top__, top__ + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom_.store(bottom__ + 1, std::memory_order_relaxed);
+			return won__;
+		}
+		return true;
+	}
+
+	template<typename Elem>
+	inline bool work_stealing_deque<Elem>::steal(Elem& elem)
+	{
+		long long top__ = top_.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const long long bottom__ = bottom_.load(std::memory_order_acquire);
+		if (top__ >= bottom__) return false;
+		const Elem stolen__ = ring_.load(std::memory_order_acquire)->get(top__);
+		if (!top_.compare_exchange_strong(top__, top__ + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return false;
+		elem = stolen__;
+		return true;
+	}
+
+	template<typename Elem>
+	inline size_t work_stealing_deque<Elem>::size() const noexcept
+	{
+		const long long bottom__ = bottom_.load(std::memory_order_relaxed);
+		const long long top__ = top_.load(std::memory_order_relaxed);
+		return bottom__ > top__ ? static_cast<size_t>(bottom__ - top__) : 0;
+	}
+
+	template<typename Elem>
+	inline bool work_stealing_deque<Elem>::empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	template<typename Elem>
+	inline typename work_stealing_deque<Elem>::_ring* work_stealing_deque<Elem>::_grow(_ring* ring, long long top, long long bottom)
+	{
+		_ring* larger__ = new _ring(ring->capacity_ << 1, ring);
+		for (long long i = top; i != bottom; i++) larger__->put(i, ring->get(i));
+		ring_.store(larger__, std::memory_order_release);
+		return larger__;
+	}
+}
+
+// ALL RIGHTS RESERVED (C) 2021 Teddy van Jerry
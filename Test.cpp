@@ -0,0 +1,1213 @@
+/*
+ * File: Test.cpp
+ * Project: TVJ_Tree
+ * --------------------------
+ *
+ * @author: Teddy van Jerry
+ * @licence: The MIT Licence
+ * @compiler: at least C++/14 (tested on MSVC and MinGW)
+ *
+ * @version 1.21 2026/10/18
+ * - hash_bytes at any alignment and with flipped bits, interner against a map
+ *
+ * @version 1.20 2026/10/18
+ * - getline, read_until, read_all and line_reader against std::getline
+ *
+ * @version 1.19 2026/10/18
+ * - string_builder and string append against std::string
+ *
+ * @version 1.18 2026/10/18
+ * - concatenations, also with the assigned string as an operand
+ *
+ * @version 1.17 2026/10/18
+ * - split and tokenize against the fields cut by hand
+ *
+ * @version 1.16 2026/10/18
+ * - integers and the shortest form of floating-point numbers written and read back
+ *
+ * @version 1.15 2026/10/18
+ * - from_chars of floating-point numbers with '+', "0x", out of range and too long
+ *
+ * @version 1.14 2026/10/18
+ * - count and locate of text_index against a naive scan
+ *
+ * @version 1.13 2026/10/18
+ * - utf8_validate against a reference on random texts
+ *
+ * @version 1.12 2026/10/18
+ * - searcher, find, count and find_all against a naive scan
+ *
+ * @version 1.11 2026/10/18
+ * - pushing an element of the stack or vector itself
+ *
+ * @version 1.10 2026/10/18
+ * - long double written and read back
+ *
+ * @version 1.9 2026/10/18
+ * - text_index loading a saved and a damaged index
+ *
+ * @version 1.8 2026/10/18
+ * - level order with extra null markers at the end
+ *
+ * @version 1.7 2026/10/18
+ * - emplace of the stacks, also when the constructor throws
+ *
+ * @version 1.6 2026/10/18
+ * - copy assignment of binary_tree (also into a shared pool) and the slab growth of node_pool
+ *
+ * @version 1.5 2026/10/18
+ * - positional access out of range
+ *
+ * @version 1.4 2026/10/18
+ * - concurrent_stack and work_stealing_deque used by several threads, checked by the sum of the values
+ *
+ * @version 1.3 2026/10/18
+ * - huffman_coding decoding valid and invalid bits
+ *
+ * @version 1.2 2026/10/18
+ * - rope against std::string, with the treap order and the chunk sizes
+ *
+ * @version 1.1 2026/10/18
+ * - inserting the data of a node into the same compact_binary_tree
+ *
+ * @version 1.0 2026/10/18
+ * - behaviour checks of the trees against the sequences built in vectors
+ *
+ */
+
+// Build and run it (also with TVJ_BT_SUBTREE_SIZE defined, and with a thread sanitizer for the concurrent parts),
+// each failed check is printed and the exit code is the number of them.
+// Build it with SSSE3 enabled (e.g. -mssse3) as well, so that utf8_validate takes its SIMD path.
+
+#include <iostream>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TVJ_Binary_Tree.h"
+#include "TVJ_Frozen_Binary_Tree.h"
+#include "TVJ_Rope.h"
+#include "TVJ_Huffman_Coding.h"
+#include "TVJ_Concurrent_Stack.h"
+#include "TVJ_Work_Stealing_Deque.h"
+#include "TVJ_Text_Index.h"
+#include "TVJ_Number.h"
+#include "TVJ_String_Split.h"
+#include "TVJ_Interner.h"
+using namespace tvj;
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { if (!(condition)) { std::cout << "FAILED (line " << __LINE__ << "): " #condition << std::endl; failures++; } } while (0)
+
+// a binary tree that also shows the sequences kept in vectors,
+// which are what the iterators and at() returned before they walked the links
+class checked_tree : public binary_tree<int>
+{
+public:
+	using binary_tree<int>::binary_tree;
+
+	vector<int> sequence(int order) const
+	{
+		const vector<BT_Node*>& nodes__ = _sequence(order == 0 ? PREORDER : order == 1 ? INORDER : POSTORDER);
+		vector<int> ret;
+		for (size_t i = 0; i != nodes__.size(); i++) ret.push_back(nodes__[i]->data_);
+		return ret;
+	}
+};
+
+template<typename Iter>
+inline vector<int> walk_forward(Iter first, Iter last)
+{
+	vector<int> ret;
+	for (; first != last; ++first) ret.push_back(*first);
+	return ret;
+}
+
+template<typename Iter>
+inline vector<int> walk_backward(Iter first, Iter last)
+{
+	vector<int> ret;
+	while (last != first)
+	{
+		--last;
+		ret.push_front(*last);
+	}
+	return ret;
+}
+
+// grow a random tree with the values 0, 1, 2, ... in the order the nodes are added
+inline void grow_random(checked_tree& tree, size_t size, unsigned seed)
+{
+	srand(seed);
+	int next__ = 0;
+	tree.set_root(next__++);
+	while (tree.size() != size)
+	{
+		auto iter__ = tree.root();
+		for (;;)
+		{
+			const bool left__ = rand() % 2;
+			if (left__ ? !iter__.has_left_child() : !iter__.has_right_child())
+			{
+				if (left__) iter__.set_left_child(next__++);
+				else iter__.set_right_child(next__++);
+				break;
+			}
+			iter__ = left__ ? iter__.left_child() : iter__.right_child();
+		}
+	}
+}
+
+// the iterators (walking the links), at() and the distances against the sequences in vectors
+inline void check_against_sequences(checked_tree& tree)
+{
+	const vector<int> pre__ = tree.sequence(0), in__ = tree.sequence(1), post__ = tree.sequence(2);
+	CHECK(in__.size() == tree.size());
+	CHECK(walk_forward(tree.preorder_cbegin(), tree.preorder_cend()) == pre__);
+	CHECK(walk_forward(tree.cbegin(), tree.cend()) == in__);
+	CHECK(walk_forward(tree.postorder_cbegin(), tree.postorder_cend()) == post__);
+	CHECK(walk_backward(tree.preorder_cbegin(), tree.preorder_cend()) == pre__);
+	CHECK(walk_backward(tree.cbegin(), tree.cend()) == in__);
+	CHECK(walk_backward(tree.postorder_cbegin(), tree.postorder_cend()) == post__);
+	const auto begin__ = tree.cbegin();
+	size_t i = 0;
+	for (auto iter__ = tree.cbegin(); iter__ != tree.cend(); ++iter__, i++)
+	{
+		CHECK(tree.at(i) == in__[i]);
+		CHECK(tree.preorder_at(i) == pre__[i]);
+		CHECK(tree.postorder_at(i) == post__[i]);
+		CHECK(static_cast<size_t>(iter__ - begin__) == i);
+		CHECK(*(begin__ + static_cast<long long>(i)) == in__[i]);
+	}
+}
+
+inline void test_binary_tree()
+{
+	for (unsigned seed = 1; seed <= 20; seed++)
+	{
+		checked_tree tree;
+		grow_random(tree, 1 + seed * 13, seed);
+		check_against_sequences(tree);
+
+		// the sequences are rebuilt lazily after a removal
+		tree.remove_at(tree.size() / 2);
+		tree.remove_at(0);
+		check_against_sequences(tree);
+
+		checked_tree copy(tree);
+		check_against_sequences(copy);
+		CHECK(copy.sequence(1) == tree.sequence(1));
+	}
+
+	// an index not less than the size (also of an empty tree) throws instead of reaching no node
+	checked_tree tree;
+	size_t thrown__ = 0;
+	try { tree.at(0); } catch (const std::out_of_range&) { thrown__++; }
+	try { tree.remove_at(0); } catch (const std::out_of_range&) { thrown__++; }
+	grow_random(tree, 10, 1);
+	try { tree.preorder_at(10); } catch (const std::out_of_range&) { thrown__++; }
+	try { tree.postorder_at(11); } catch (const std::out_of_range&) { thrown__++; }
+	try { tree.remove_at(10); } catch (const std::out_of_range&) { thrown__++; }
+	CHECK(thrown__ == 5 && tree.size() == 10);
+
+	// copy assignment rebuilds the nodes in the pool of the target
+	binary_tree<int>::pool_type shared;
+	checked_tree into_shared(shared), into_own, empty;
+	grow_random(into_own, 25, 3);
+	into_shared = tree;
+	into_own = tree;
+	CHECK(into_shared.sequence(0) == tree.sequence(0) && into_shared.sequence(1) == tree.sequence(1));
+	CHECK(into_own.sequence(0) == tree.sequence(0) && into_own.sequence(2) == tree.sequence(2));
+	CHECK(shared.size() == tree.size());
+	check_against_sequences(into_own);
+	into_own = into_own;
+	CHECK(into_own.size() == tree.size());
+	into_shared = empty;
+	CHECK(into_shared.size() == 0 && shared.size() == 0 && into_shared.cbegin() == into_shared.cend());
+	checked_tree copied_empty(empty);
+	CHECK(copied_empty.size() == 0);
+}
+
+// counts how it is made, and the constructor throws for a negative number
+struct counted
+{
+	static int copies_;
+	std::string text_;
+	int number_ = 0;
+
+	counted() = default;
+	counted(const char* text, int number) : text_(text), number_(number)
+	{
+		if (number < 0) throw std::invalid_argument("negative");
+	}
+	counted(const counted& another) : text_(another.text_), number_(another.number_) { copies_++; }
+	counted& operator=(const counted& another)
+	{
+		text_ = another.text_;
+		number_ = another.number_;
+		copies_++;
+		return *this;
+	}
+	counted(counted&&) = default;
+	counted& operator=(counted&&) = default;
+};
+
+int counted::copies_ = 0;
+
+template<typename Stack>
+inline void check_emplace(Stack& s, int count)
+{
+	counted::copies_ = 0;
+	for (int i = 0; i != count; i++) s.emplace("element", i);
+	bool thrown__ = false;
+	try { s.emplace("element", -1); } catch (const std::invalid_argument&) { thrown__ = true; }
+	CHECK(thrown__ && s.size() == static_cast<size_t>(count) && counted::copies_ == 0);
+	int sum__ = 0;
+	while (!s.empty()) sum__ += s.pop().number_;
+	CHECK(sum__ == count * (count - 1) / 2);
+}
+
+inline void test_stacks()
+{
+	stack<counted> s;
+	check_emplace(s, 1000);
+	inline_stack<counted, 16> inline_s;
+	check_emplace(inline_s, 15);
+	segmented_stack<counted> segmented_s;
+	check_emplace(segmented_s, 1000);
+
+	// pushing an element of the container itself, also when the array grows under it
+	stack<std::string> strings;
+	strings.push("a string too long to be kept in place by std::string");
+	for (int i = 0; i != 100; i++) strings.push(strings.top());
+	bool same__ = strings.size() == 101;
+	while (!strings.empty()) same__ = strings.pop() == "a string too long to be kept in place by std::string" && same__;
+	CHECK(same__);
+	stack<std::string> emplaced;
+	emplaced.emplace(40, 'x');
+	for (int i = 0; i != 100; i++) emplaced.emplace(emplaced.top());
+	same__ = emplaced.size() == 101;
+	while (!emplaced.empty()) same__ = emplaced.pop() == std::string(40, 'x') && same__;
+	CHECK(same__);
+	vector<std::string> values;
+	values.push_back(std::string(40, 'y'));
+	for (int i = 0; i != 100; i++) values.push_back(values[values.size() - 1]);
+	for (int i = 0; i != 100; i++) values.push_front(values[values.size() - 1]);
+	same__ = values.size() == 201;
+	for (size_t i = 0; i != values.size(); i++) same__ = values[i] == std::string(40, 'y') && same__;
+	CHECK(same__);
+}
+
+inline void test_node_pool()
+{
+	// slabs of 32, 64 and 128 nodes, a small one reserved, and then the next slab is twice the largest
+	node_pool<long long> pool;
+	std::vector<long long*> nodes;
+	for (int i = 0; i != 32 + 64 + 128; i++) nodes.push_back(pool.create(i));
+	CHECK(pool.capacity() == 224);
+	pool.reserve(5);
+	CHECK(pool.capacity() == 229);
+	for (int i = 0; i != 6; i++) nodes.push_back(pool.create(i));
+	CHECK(pool.capacity() == 229 + 256 && pool.size() == 230);
+	for (size_t i = 0; i != nodes.size(); i++) pool.destroy(nodes[i]);
+	CHECK(pool.size() == 0);
+}
+
+inline void test_freeze()
+{
+	for (unsigned seed = 1; seed <= 10; seed++)
+	{
+		checked_tree tree;
+		grow_random(tree, seed * 37, seed);
+		const frozen_binary_tree<int> frozen__ = freeze(tree);
+		CHECK(walk_forward(frozen__.preorder_cbegin(), frozen__.preorder_cend()) == tree.sequence(0));
+		CHECK(walk_forward(frozen__.cbegin(), frozen__.cend()) == tree.sequence(1));
+		CHECK(walk_forward(frozen__.postorder_cbegin(), frozen__.postorder_cend()) == tree.sequence(2));
+		CHECK(walk_backward(frozen__.cbegin(), frozen__.cend()) == tree.sequence(1));
+	}
+
+	// search in a sorted tree against a linear scan of the sequence
+	vector<int> sorted__;
+	for (int i = 0; i != 100; i++) sorted__.push_back(i * 2);
+	checked_tree tree;
+	tree.build_balanced(sorted__);
+	const frozen_binary_tree<int> frozen__ = freeze(tree);
+	for (int value = -2; value != 202; value++)
+	{
+		const auto found__ = frozen__.search(value);
+		int expected__ = -1;
+		for (size_t i = 0; i != sorted__.size(); i++) if (sorted__[i] <= value) expected__ = sorted__[i];
+		CHECK(expected__ == -1 ? found__.is_before_begin() : *found__ == expected__);
+		CHECK(frozen__.contains(value) == (value >= 0 && value < 200 && value % 2 == 0));
+	}
+}
+
+// a child holding the data of its parent, which lives in the array that grows
+inline void test_compact_self_insertion()
+{
+	compact_binary_tree<std::string> tree;
+	auto iter__ = tree.set_root(std::string(40, 'a'));
+	for (size_t i = 1; i != 200; i++)
+	{
+		iter__.set_left_child(*iter__);
+		iter__.set_right_child(*iter__);
+		iter__ = iter__.left_child();
+	}
+	CHECK(tree.size() == 2 * 200 - 1);
+	size_t good__ = 0;
+	for (auto iter = tree.cbegin(); iter != tree.cend(); ++iter) good__ += *iter == std::string(40, 'a');
+	CHECK(good__ == tree.size());
+}
+
+// a rope that also checks its treap
+class checked_rope : public rope
+{
+public:
+	using rope::rope;
+
+	// the priorities are in heap order, the totals add up and each chunk fits its room
+	bool valid() const
+	{
+		return _valid(root_, ~0u);
+	}
+
+	std::string str() const
+	{
+		const string flat__ = to_string();
+		return std::string(flat__.data(), flat__.size());
+	}
+
+protected:
+	static bool _valid(const Rope_Node* node, unsigned priority)
+	{
+		if (!node) return true;
+		return node->priority_ <= priority && node->length_ && node->length_ <= node->capacity_ && node->capacity_ <= ROPE_CHUNK_SIZE
+			&& node->total_ == _total(node->L_child_) + node->length_ + _total(node->R_child_)
+			&& _valid(node->L_child_, node->priority_) && _valid(node->R_child_, node->priority_);
+	}
+};
+
+inline void test_rope()
+{
+	srand(43);
+	checked_rope text;
+	std::string expected;
+	for (int step = 0; step != 3000; step++)
+	{
+		const int op__ = rand() % 4;
+		if (op__ == 0)
+		{
+			const std::string piece__(rand() % 3000, static_cast<char>('a' + rand() % 26));
+			const size_t index__ = rand() % (expected.size() + 1);
+			text.insert(index__, piece__.data(), piece__.size());
+			expected.insert(index__, piece__);
+		}
+		else if (op__ == 1 && !expected.empty())
+		{
+			const size_t index__ = rand() % expected.size();
+			const size_t count__ = rand() % (expected.size() - index__ + 1);
+			text.erase(index__, count__);
+			expected.erase(index__, count__);
+		}
+		else if (op__ == 2)
+		{
+			checked_rope tail;
+			static_cast<rope&>(tail) = text.split(rand() % (expected.size() + 1));
+			CHECK(tail.valid());
+			text.concat(tail);
+		}
+		else
+		{
+			const char ch__ = static_cast<char>('A' + rand() % 26);
+			text.append(ch__);
+			expected += ch__;
+		}
+		CHECK(text.valid());
+		CHECK(text.size() == expected.size());
+	}
+	CHECK(text.str() == expected);
+
+	// two small chunks left after an erase become one
+	checked_rope small(std::string(600, 'x').data(), 600);
+	small.append(std::string(600, 'y').data(), 600);
+	small.erase(100, 1000);
+	checked_rope copy;
+	copy = small;
+	size_t chunks__ = 0;
+	const rope::chunk_iterator end__ = copy.chunk_cend();
+	for (auto iter__ = copy.chunk_cbegin(); iter__ != end__; ++iter__) chunks__++;
+	CHECK(chunks__ == 1 && copy.str() == std::string(100, 'x') + std::string(100, 'y'));
+}
+
+// the occurrences (overlapping ones included) found by comparing at every index
+inline std::vector<size_t> naive_find_all(const std::string& text, const std::string& pattern)
+{
+	std::vector<size_t> ret;
+	for (size_t i = 0; i + pattern.size() <= text.size(); i++)
+	{
+		if (text.compare(i, pattern.size(), pattern) == 0) ret.push_back(i);
+	}
+	return ret;
+}
+
+inline void test_search()
+{
+	// on alphabets of 1 to 4 letters, with patterns of 1 char (memchr), shorter than TVJ_SEARCH_TWO_WAY_THRESHOLD
+	// (the first/last filter, 16 positions at a time with SSE2) and longer (Two-Way)
+	srand(26);
+	for (int round = 0; round != 3000; round++)
+	{
+		const int letters__ = 1 + rand() % 4;
+		std::string text__(rand() % 400, 'a');
+		for (size_t i = 0; i != text__.size(); i++) text__[i] = static_cast<char>('a' + rand() % letters__);
+		const size_t length__ = 1 + rand() % 70;
+		std::string pattern__;
+		if (rand() % 2 && length__ <= text__.size()) pattern__ = text__.substr(rand() % (text__.size() - length__ + 1), length__);
+		else
+		{
+			pattern__.assign(length__, 'a');
+			for (size_t i = 0; i != length__; i++) pattern__[i] = static_cast<char>('a' + rand() % letters__);
+		}
+		const std::vector<size_t> expected__ = naive_find_all(text__, pattern__);
+
+		const searcher compiled__(pattern__.data(), pattern__.size());
+		std::vector<size_t> found__;
+		for (size_t pos__ = compiled__.find(text__.data(), text__.size()); pos__ != text__.size(); pos__ = compiled__.find(text__.data(), text__.size(), pos__ + 1))
+		{
+			found__.push_back(pos__);
+		}
+		CHECK(found__ == expected__);
+		std::vector<size_t> visited__;
+		compiled__.for_each(text__.data(), text__.size(), [&visited__](size_t index) { visited__.push_back(index); });
+		CHECK(visited__ == expected__);
+		CHECK(compiled__.count(text__.data(), text__.size()) == expected__.size());
+
+		const string text(text__.c_str()), pattern(pattern__.c_str());
+		const size_t pos__ = rand() % (text__.size() + 1);
+		const size_t first__ = text__.find(pattern__, pos__);
+		CHECK(text.find(pattern, pos__) == (first__ == std::string::npos ? text__.size() : first__));
+		CHECK(text.count(pattern) == expected__.size());
+		const vector<size_t> all__ = text.find_all(pattern);
+		bool same__ = all__.size() == expected__.size();
+		for (size_t i = 0; same__ && i != all__.size(); i++) same__ = all__[i] == expected__[i];
+		CHECK(same__);
+	}
+}
+
+// the well-formed UTF-8 of RFC 3629 checked one sequence at a time
+inline bool reference_utf8_valid(const std::string& bytes)
+{
+	static const uint32_t smallest__[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+	for (size_t i = 0; i != bytes.size();)
+	{
+		const unsigned char lead__ = static_cast<unsigned char>(bytes[i]);
+		size_t length__ = 1;
+		uint32_t code_point__ = lead__;
+		if (lead__ >= 0x80)
+		{
+			if ((lead__ & 0xE0) == 0xC0) length__ = 2, code_point__ = lead__ & 0x1F;
+			else if ((lead__ & 0xF0) == 0xE0) length__ = 3, code_point__ = lead__ & 0x0F;
+			else if ((lead__ & 0xF8) == 0xF0) length__ = 4, code_point__ = lead__ & 0x07;
+			else return false;
+			if (bytes.size() - i < length__) return false;
+			for (size_t k = 1; k != length__; k++)
+			{
+				const unsigned char next__ = static_cast<unsigned char>(bytes[i + k]);
+				if ((next__ & 0xC0) != 0x80) return false;
+				code_point__ = code_point__ << 6 | (next__ & 0x3F);
+			}
+			if (code_point__ < smallest__[length__] || code_point__ > 0x10FFFF || (code_point__ >= 0xD800 && code_point__ <= 0xDFFF)) return false;
+		}
+		i += length__;
+	}
+	return true;
+}
+
+// a code point written in UTF-8 without the checks, so surrogates and those above U+10FFFF can be written too
+inline void append_utf8(std::string& bytes, uint32_t code_point)
+{
+	if (code_point < 0x80) bytes += static_cast<char>(code_point);
+	else if (code_point < 0x800) bytes += static_cast<char>(0xC0 | code_point >> 6);
+	else if (code_point < 0x10000) bytes += static_cast<char>(0xE0 | code_point >> 12);
+	else bytes += static_cast<char>(0xF0 | code_point >> 18);
+	for (int shift = code_point < 0x80 ? -6 : code_point < 0x800 ? 0 : code_point < 0x10000 ? 6 : 12; shift >= 0; shift -= 6)
+	{
+		bytes += static_cast<char>(0x80 | (code_point >> shift & 0x3F));
+	}
+}
+
+inline void test_utf8_validate()
+{
+	// well-formed texts longer than one block of 16 bytes with at most one broken piece somewhere,
+	// and texts of random bytes
+	static const char* const broken[] = {
+		"\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF", // overlong
+		"\xED\xA0\x80", "\xED\xBF\xBF",                                                           // surrogates
+		"\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF",                                            // above U+10FFFF
+		"\x80", "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xE2\x28\xA1"                                  // lone or cut short
+	};
+	static const uint32_t ranges[][2] = { { 0x20, 0x7E }, { 0x80, 0x7FF }, { 0x800, 0xFFFF }, { 0x10000, 0x10FFFF } };
+	srand(34);
+	for (int round = 0; round != 20000; round++)
+	{
+		std::string bytes__;
+		const size_t length__ = 17 + rand() % 120;
+		if (round % 4 == 3)
+		{
+			while (bytes__.size() < length__) bytes__ += static_cast<char>(rand() % 256);
+		}
+		else
+		{
+			while (bytes__.size() < length__)
+			{
+				const int kind__ = rand() % 4;
+				const uint32_t low__ = ranges[kind__][0], high__ = ranges[kind__][1];
+				const uint32_t code_point__ = low__ + static_cast<uint32_t>(rand()) % (high__ - low__ + 1);
+				append_utf8(bytes__, code_point__ >= 0xD800 && code_point__ <= 0xDFFF ? code_point__ - 0x800 : code_point__);
+			}
+			const int where__ = round % 4;
+			const std::string piece__ = broken[rand() % (sizeof(broken) / sizeof(broken[0]))];
+			if (where__ == 1) bytes__.insert(rand() % 2 ? bytes__.size() / 2 : bytes__.size() - rand() % 17, piece__); // maybe inside a sequence
+			else if (where__ == 2) bytes__ += piece__; // at the end, e.g. a sequence truncated there
+		}
+		CHECK(utf8_validate(bytes__.data(), bytes__.size()) == reference_utf8_valid(bytes__));
+	}
+}
+
+// whether a char is one of a few delimiters, a predicate that is not a delimiter_set
+struct is_punctuation
+{
+	bool operator()(char ch) const { return ch == ',' || ch == ';' || ch == ' '; }
+};
+
+inline void test_split()
+{
+	// fields (also empty ones) and tokens of random texts with delimiter sets of 1 char (memchr), of up to
+	// SPLIT_SIMD_DELIMITERS chars (16 chars at a time) and of more, across the blocks of 16 chars
+	static const char chars[] = "ab,; |:/-+=.!?";
+	static const char* const sets[] = { ",", ",;", ",; |:/-+", ",; |:/-+=.!" };
+	srand(36);
+	for (int round = 0; round != 2000; round++)
+	{
+		std::string text__(rand() % 100, 'a');
+		for (size_t i = 0; i != text__.size(); i++) text__[i] = chars[rand() % (round % 2 ? 3 : sizeof(chars) - 1)];
+		const std::string delims__ = sets[round % 4];
+		std::vector<std::string> fields__(1), tokens__;
+		for (size_t i = 0; i != text__.size(); i++)
+		{
+			if (delims__.find(text__[i]) == std::string::npos) fields__.back() += text__[i];
+			else fields__.push_back(std::string());
+		}
+		for (size_t i = 0; i != fields__.size(); i++)
+		{
+			if (!fields__[i].empty()) tokens__.push_back(fields__[i]);
+		}
+
+		const string_view text(text__.data(), text__.size());
+		std::vector<std::string> split__;
+		const split_range range__ = split(text, string_view(delims__.c_str()));
+		for (split_range::const_iterator iter__ = range__.begin(); iter__ != range__.end(); ++iter__)
+		{
+			split__.push_back(std::string((*iter__).data(), (*iter__).size()));
+		}
+		CHECK(split__ == fields__);
+		std::vector<std::string> tokenized__;
+		const token_range<delimiter_set> set_tokens__ = tokenize(text, delimiter_set(string_view(delims__.c_str())));
+		for (token_range<delimiter_set>::const_iterator iter__ = set_tokens__.begin(); iter__ != set_tokens__.end(); ++iter__)
+		{
+			tokenized__.push_back(std::string((*iter__).data(), (*iter__).size()));
+		}
+		CHECK(tokenized__ == tokens__);
+	}
+
+	// the tokens by a predicate
+	const token_range<is_punctuation> words = tokenize(string_view(" one,,two; three "), is_punctuation());
+	std::vector<std::string> found;
+	for (token_range<is_punctuation>::const_iterator iter = words.begin(); iter != words.end(); ++iter)
+	{
+		found.push_back(std::string((*iter).data(), (*iter).size()));
+	}
+	CHECK(found.size() == 3 && found[0] == "one" && found[1] == "two" && found[2] == "three");
+	// an empty text is one empty field
+	const split_range empty = split(string_view(""), string_view(","));
+	split_range::const_iterator field = empty.begin();
+	CHECK(field != empty.end() && (*field).size() == 0 && ++field == empty.end());
+}
+
+inline std::string as_std_string(const string& str)
+{
+	return std::string(str.data(), str.size());
+}
+
+inline void test_string_concat()
+{
+	// chains of strings, c-style strings and chars, also with the target as an operand
+	srand(37);
+	for (int round = 0; round != 500; round++)
+	{
+		const std::string b__(rand() % 40, static_cast<char>('a' + rand() % 26)), c__(rand() % 40, static_cast<char>('a' + rand() % 26));
+		std::string a__(rand() % 40, static_cast<char>('a' + rand() % 26));
+		string a(a__.c_str());
+		const string b(b__.c_str()), c(c__.c_str());
+		switch (round % 7)
+		{
+		case 0: a = b + a; a__ = b__ + a__; break;
+		case 1: a = a + a + '!'; a__ = a__ + a__ + '!'; break;
+		case 2: a += a + b; a__ += a__ + b__; break;
+		case 3: a = "<" + a + ">"; a__ = "<" + a__ + ">"; break;
+		case 4: a = (a + b) + (c + a); a__ = (a__ + b__) + (c__ + a__); break;
+		case 5: a = '[' + b + c + ']'; a__ = '[' + b__ + c__ + ']'; break;
+		default: a = string(b + "-" + c); a__ = b__ + "-" + c__; break;
+		}
+		CHECK(as_std_string(a) == a__ && a.data()[a.size()] == 0);
+	}
+}
+
+inline void test_string_builder()
+{
+	// every kind of append against std::string, taken over as a string now and then
+	srand(29);
+	string_builder builder;
+	std::string expected;
+	for (int step = 0; step != 5000; step++)
+	{
+		const std::string piece__(rand() % 50, static_cast<char>('a' + rand() % 26));
+		switch (rand() % 8)
+		{
+		case 0: builder.append(piece__.data(), piece__.size()); expected += piece__; break;
+		case 1: builder << piece__.c_str(); expected += piece__; break;
+		case 2: builder << string(piece__.c_str()); expected += piece__; break;
+		case 3: builder << piece__[0]; expected += piece__[0]; break;
+		case 4: builder.append(piece__.size(), '#'); expected.append(piece__.size(), '#'); break;
+		case 5: builder << step << ' ' << -0.5; expected += std::to_string(step) + " -0.5"; break;
+		case 6: builder.reserve(builder.size() + piece__.size()); CHECK(builder.capacity() >= expected.size() + piece__.size()); break;
+		default:
+			if (rand() % 20 == 0)
+			{
+				const string taken__ = builder.take();
+				CHECK(as_std_string(taken__) == expected && taken__.data()[taken__.size()] == 0 && builder.empty());
+				expected.clear();
+			}
+		}
+		CHECK(builder.size() == expected.size());
+	}
+	string_builder copy(builder);
+	CHECK(as_std_string(copy.take()) == expected && as_std_string(builder.take()) == expected);
+	builder << "dropped";
+	builder.clear();
+	CHECK(builder.empty() && as_std_string(builder.take()).empty());
+
+	// appending to a string, also a part of itself while it grows
+	string text("abc");
+	std::string text__ = "abc";
+	for (int i = 0; i != 12; i++)
+	{
+		text.append(text.data() + i % text.size(), text.size() - i % text.size());
+		text__ += text__.substr(i % text__.size());
+		text.append('!');
+		text__ += '!';
+	}
+	CHECK(as_std_string(text) == text__ && text.data()[text.size()] == 0);
+}
+
+inline void test_string_io()
+{
+	// lines of any length (one longer than the block of line_reader), empty ones, with or without the last '\n'
+	srand(31);
+	for (int round = 0; round != 20; round++)
+	{
+		std::string content;
+		const int lines__ = rand() % 30;
+		for (int i = 0; i != lines__; i++)
+		{
+			const size_t length__ = i == 3 && round % 5 == 0 ? LINE_READER_BUFFER_SIZE + 1000 : rand() % 4 ? rand() % 40 : rand() % 2000;
+			content += std::string(length__, static_cast<char>('a' + rand() % 26));
+			if (i != lines__ - 1 || round % 2) content += '\n';
+		}
+		std::vector<std::string> expected__;
+		std::istringstream std_in__(content);
+		for (std::string line__; std::getline(std_in__, line__);) expected__.push_back(line__);
+
+		std::istringstream getline_in__(content);
+		std::vector<std::string> got__;
+		for (string line__; getline(getline_in__, line__);) got__.push_back(as_std_string(line__));
+		CHECK(got__ == expected__);
+
+		std::istringstream until_in__(content);
+		std::string joined__;
+		for (string piece__; read_until(until_in__, piece__, '\n');) joined__ += as_std_string(piece__);
+		CHECK(joined__ == content);
+
+		std::istringstream all_in__(content);
+		string all__;
+		CHECK(read_all(all_in__, all__) && as_std_string(all__) == content);
+
+		std::istringstream reader_in__(content);
+		line_reader reader__(reader_in__);
+		got__.clear();
+		for (string line__; reader__.next(line__);) got__.push_back(as_std_string(line__));
+		CHECK(got__ == expected__ && reader__.line_number() == expected__.size());
+
+		std::FILE* file__ = std::tmpfile();
+		CHECK(file__ != nullptr);
+		if (!file__) continue;
+		std::fwrite(content.data(), 1, content.size(), file__);
+		std::rewind(file__);
+		CHECK(read_all(file__, all__) && as_std_string(all__) == content);
+		std::rewind(file__);
+		line_reader file_reader__(file__);
+		got__.clear();
+		for (string line__; file_reader__.next(line__);) got__.push_back(as_std_string(line__));
+		CHECK(got__ == expected__);
+		std::fclose(file__);
+	}
+}
+
+inline void test_hash_and_interner()
+{
+	// the same bytes at any alignment give the same hash, one flipped bit or another seed a different one
+	unsigned char bytes[128 + 8];
+	for (size_t i = 0; i != sizeof(bytes); i++) bytes[i] = static_cast<unsigned char>(i * 37 + 11);
+	for (size_t length = 0; length <= 128; length++)
+	{
+		const uint64_t hash__ = hash_bytes(bytes, length);
+		unsigned char moved__[128 + 8];
+		for (size_t offset = 1; offset != 8; offset++)
+		{
+			memcpy(moved__ + offset, bytes, length);
+			CHECK(hash_bytes(moved__ + offset, length) == hash__);
+		}
+		CHECK(hash_bytes(bytes, length, 1) != hash__ && hash_bytes(bytes, length + 1) != hash__);
+		for (size_t bit = 0; bit != length * 8; bit++)
+		{
+			bytes[bit / 8] ^= static_cast<unsigned char>(1 << bit % 8);
+			CHECK(hash_bytes(bytes, length) != hash__);
+			bytes[bit / 8] ^= static_cast<unsigned char>(1 << bit % 8);
+		}
+	}
+	const string word("interned");
+	CHECK(hash(word) == hash(string_view(word)) && hash(word) == hash_bytes(word.data(), word.size()));
+
+	// ids in the order the strings first appear, against a map
+	srand(32);
+	interner table;
+	std::map<std::string, uint32_t> expected;
+	std::vector<std::string> by_id;
+	for (int step = 0; step != 20000; step++)
+	{
+		std::string word__(rand() % 7, 'a');
+		for (size_t i = 0; i != word__.size(); i++) word__[i] = static_cast<char>('a' + rand() % 4);
+		if (step % 1000 == 999) word__ = std::string(INTERNER_BLOCK_SIZE / 4 + step, 'x'); // a block of its own
+		const uint32_t id__ = table.intern(string_view(word__.data(), word__.size()));
+		if (expected.insert(std::make_pair(word__, static_cast<uint32_t>(by_id.size()))).second) by_id.push_back(word__);
+		CHECK(id__ == expected[word__]);
+		if (step == 10000) table.reserve(100000);
+	}
+	CHECK(table.size() == by_id.size() && !table.contains(string_view("aaaaaaa")));
+	bool same = true;
+	for (uint32_t id = 0; id != by_id.size(); id++)
+	{
+		const string_view view__ = table.view(id);
+		same = same && std::string(view__.data(), view__.size()) == by_id[id] && table.find(view__) == id;
+	}
+	CHECK(same);
+	table.clear();
+	CHECK(table.size() == 0 && table.find(string_view("ab")) == INTERNER_INVALID_ID && table.intern(string_view("ab")) == 0);
+}
+
+inline void test_huffman_decode()
+{
+	const huffman_coding coding(string("abracadabra alakazam"), HF_TEXT);
+	const string text("a cab abracadabra");
+	bit_string bits;
+	string decoded;
+	CHECK(coding.encode(text, HF_TEXT, bits));
+	CHECK(coding.decode(bits, decoded) && decoded == text);
+	string bits_text;
+	coding.encode(text, HF_TEXT, bits_text);
+	CHECK(coding.decode(bits_text, HF_TEXT, decoded) && decoded == text);
+
+	// a code cut off at the end, or a char that is not a bit
+	bits.pop_back();
+	CHECK(!coding.decode(bits, decoded));
+	bits_text.append('2');
+	CHECK(!coding.decode(bits_text, HF_TEXT, decoded));
+
+	// the only code of a single symbol is 0, so bit 1 leads to no node
+	const huffman_coding single(string("zzz"), HF_TEXT);
+	CHECK(single.decode(bit_string(string("00")), decoded) && decoded == string("zz"));
+	CHECK(!single.decode(bit_string(string("01")), decoded));
+}
+
+#define STRESS_THREADS 4      // the number of threads of each kind
+#define STRESS_VALUES 100000  // the number of values each thread pushes
+
+// push the values thread * STRESS_VALUES + 1, ..., (thread + 1) * STRESS_VALUES, popping one after every second push
+inline void _stack_worker(concurrent_stack<long long>* stack, unsigned thread, std::atomic<long long>* popped_sum, std::atomic<long long>* popped_count)
+{
+	long long sum__ = 0, count__ = 0, value__;
+	for (long long i = 1; i <= STRESS_VALUES; i++)
+	{
+		stack->push(thread * static_cast<long long>(STRESS_VALUES) + i);
+		if (i % 2 == 0 && stack->pop(value__))
+		{
+			sum__ += value__;
+			count__++;
+		}
+	}
+	popped_sum->fetch_add(sum__);
+	popped_count->fetch_add(count__);
+}
+
+// steal until the owner is done and the deque is empty
+inline void _thief(work_stealing_deque<long long>* deque, const std::atomic<bool>* done, std::atomic<long long>* stolen_sum, std::atomic<long long>* stolen_count)
+{
+	long long sum__ = 0, count__ = 0, value__;
+	while (!done->load() || !deque->empty())
+	{
+		if (deque->steal(value__))
+		{
+			sum__ += value__;
+			count__++;
+		}
+	}
+	stolen_sum->fetch_add(sum__);
+	stolen_count->fetch_add(count__);
+}
+
+inline void test_concurrent()
+{
+	const long long total__ = static_cast<long long>(STRESS_THREADS) * STRESS_VALUES;
+	const long long checksum__ = total__ * (total__ + 1) / 2;
+
+	// each value pushed is popped exactly once, either by a worker or at the end
+	concurrent_stack<long long> stack;
+	std::atomic<long long> sum(0), count(0);
+	std::thread workers[STRESS_THREADS];
+	for (unsigned k = 0; k != STRESS_THREADS; k++) workers[k] = std::thread(_stack_worker, &stack, k, &sum, &count);
+	for (unsigned k = 0; k != STRESS_THREADS; k++) workers[k].join();
+	long long value;
+	while (stack.pop(value))
+	{
+		sum += value;
+		count++;
+	}
+	CHECK(count == total__ && sum == checksum__ && stack.empty());
+
+	// the owner pushes (growing the ring) and pops while the thieves steal from the top
+	work_stealing_deque<long long> deque;
+	std::atomic<bool> done(false);
+	sum = 0;
+	count = 0;
+	std::thread thieves[STRESS_THREADS];
+	for (unsigned k = 0; k != STRESS_THREADS; k++) thieves[k] = std::thread(_thief, &deque, &done, &sum, &count);
+	long long owned_sum = 0, owned_count = 0;
+	for (long long i = 1; i <= total__; i++)
+	{
+		deque.push(i);
+		if (i % 3 == 0 && deque.pop(value))
+		{
+			owned_sum += value;
+			owned_count++;
+		}
+	}
+	while (deque.pop(value))
+	{
+		owned_sum += value;
+		owned_count++;
+	}
+	done = true;
+	for (unsigned k = 0; k != STRESS_THREADS; k++) thieves[k].join();
+	CHECK(count + owned_count == total__ && sum + owned_sum == checksum__ && deque.empty());
+}
+
+inline void test_text_index_load()
+{
+	const string text("abracadabra, the cat sat on the mat and the rat ran to the cabin");
+	const text_index index(text);
+	std::FILE* file = std::tmpfile();
+	CHECK(file && index.save(file));
+	if (!file) return;
+	const long size = std::ftell(file);
+
+	// every byte changed in turn, the index is either rejected (and empty) or answers as before
+	for (long offset = 0; offset < size; offset++)
+	{
+		std::fseek(file, offset, SEEK_SET);
+		const int original = std::fgetc(file);
+		std::fseek(file, offset, SEEK_SET);
+		std::fputc(original ^ 0x5A, file);
+		std::rewind(file);
+		text_index loaded;
+		if (loaded.load(file)) CHECK(loaded.locate(string("at")) == index.locate(string("at")) && loaded.count(string("the")) == 4);
+		else CHECK(loaded.size() == 0);
+		std::fseek(file, offset, SEEK_SET);
+		std::fputc(original, file);
+	}
+	std::rewind(file);
+	text_index loaded;
+	CHECK(loaded.load(file) && loaded.size() == text.size() && loaded.count(string("a")) == index.count(string("a")));
+	std::fclose(file);
+}
+
+inline void test_text_index_search()
+{
+	// random texts, runs of one letter and periodic texts, longer than the checkpoints and the samples of the index
+	srand(38);
+	for (int round = 0; round != 300; round++)
+	{
+		const int kind__ = round % 3;
+		std::string text__(1 + rand() % 1500, 'a');
+		const size_t period__ = 1 + rand() % 7;
+		for (size_t i = 0; i != text__.size(); i++)
+		{
+			if (kind__ == 0) text__[i] = static_cast<char>('a' + rand() % (1 + round % 4));
+			else if (kind__ == 2) text__[i] = static_cast<char>('a' + i % period__ % 3);
+		}
+		const text_index index(text__.data(), text__.size());
+		for (int query = 0; query != 20; query++)
+		{
+			std::string pattern__;
+			switch (query % 5)
+			{
+			case 0: pattern__ = std::string(1, static_cast<char>('a' + rand() % 4)); break; // one char, maybe absent
+			case 1: pattern__ = "z"; break;                                                 // absent
+			case 2: pattern__ = text__; break;                                              // the whole text
+			default:
+			{
+				const size_t index__ = rand() % text__.size();
+				pattern__ = text__.substr(index__, 1 + rand() % (text__.size() - index__));
+				if (query % 5 == 4) pattern__ += static_cast<char>('a' + rand() % 4); // maybe absent
+			}
+			}
+			const std::vector<size_t> expected__ = naive_find_all(text__, pattern__);
+			CHECK(index.count(pattern__.data(), pattern__.size()) == expected__.size());
+			const vector<size_t> found__ = index.locate(pattern__.data(), pattern__.size());
+			bool same__ = found__.size() == expected__.size();
+			for (size_t i = 0; same__ && i != found__.size(); i++) same__ = found__[i] == expected__[i];
+			CHECK(same__);
+		}
+	}
+}
+
+inline void test_long_double()
+{
+	const long double values[] = { 0.1L, 1.0L / 3, -2.5e-300L, 123456789.123456789L };
+	for (size_t i = 0; i != sizeof(values) / sizeof(values[0]); i++)
+	{
+		const string text = to_string(values[i]);
+		long double back = 0;
+		CHECK(from_chars(string_view(text), back) && back == values[i]);
+	}
+}
+
+template<typename Int>
+inline void check_integer_round_trip()
+{
+	const Int values[] = { std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max(), 0, 1, static_cast<Int>(std::numeric_limits<Int>::max() / 10) };
+	for (size_t i = 0; i != sizeof(values) / sizeof(values[0]); i++)
+	{
+		char buffer[NUMBER_MAX_CHARS];
+		const char* const end = to_chars(buffer, values[i]);
+		Int back = 0;
+		CHECK(from_chars(buffer, end, back) == end && back == values[i]);
+		CHECK(std::string(buffer, static_cast<size_t>(end - buffer)) == std::to_string(values[i]));
+	}
+	for (int i = 0; i != 1000; i++)
+	{
+		const Int value = static_cast<Int>(static_cast<unsigned long long>(rand()) << 40 ^ static_cast<unsigned long long>(rand()) << 20 ^ rand());
+		Int back = 0;
+		CHECK(from_chars(string_view(to_string(value)), back) && back == value);
+	}
+
+	// one past the maximum (and the minimum) is rejected, the value is unchanged
+	std::string above = std::to_string(std::numeric_limits<Int>::max());
+	above[above.size() - 1]++;
+	Int unchanged = 7;
+	CHECK(!from_chars(string_view(above.c_str()), unchanged) && unchanged == 7);
+	std::string below = std::numeric_limits<Int>::is_signed ? std::to_string(std::numeric_limits<Int>::min()) : "-1";
+	if (std::numeric_limits<Int>::is_signed) below[below.size() - 1]++;
+	CHECK(!from_chars(string_view(below.c_str()), unchanged) && unchanged == 7);
+	CHECK(!from_chars(string_view((above + "0").c_str()), unchanged) && !from_chars(string_view("-"), unchanged) && unchanged == 7);
+}
+
+// the significant digits of a number written by to_chars (the zeros at both ends are not)
+inline size_t significant_digits(const char* first, const char* last)
+{
+	std::string digits;
+	for (; first != last && *first != 'e'; first++)
+	{
+		if (*first >= '0' && *first <= '9') digits += *first;
+	}
+	const size_t begin = digits.find_first_not_of('0');
+	return begin == std::string::npos ? 0 : digits.find_last_not_of('0') - begin + 1;
+}
+
+template<typename Float>
+inline void check_float_round_trip(Float value)
+{
+	char buffer[NUMBER_MAX_CHARS];
+	const char* const end = to_chars(buffer, value);
+	Float back = 0;
+	CHECK(from_chars(buffer, end, back) == end && back == value);
+	// no more significant digits than the shortest %g form that reads back
+	// (std::to_chars writes an integer in full instead when that takes no more chars)
+	char shortest[NUMBER_MAX_CHARS * 2];
+	int length = 0;
+	for (int precision = 1; precision <= 17; precision++)
+	{
+		length = std::snprintf(shortest, sizeof(shortest), "%.*g", precision, static_cast<double>(value));
+		Float shortest_value = 0;
+		if (from_chars(shortest, shortest + length, shortest_value) && shortest_value == value) break;
+	}
+	CHECK(significant_digits(buffer, end) <= significant_digits(shortest, shortest + length) || end - buffer <= length);
+}
+
+inline void test_number_round_trip()
+{
+	srand(39);
+	check_integer_round_trip<signed char>();
+	check_integer_round_trip<unsigned char>();
+	check_integer_round_trip<short>();
+	check_integer_round_trip<unsigned short>();
+	check_integer_round_trip<int>();
+	check_integer_round_trip<unsigned>();
+	check_integer_round_trip<long long>();
+	check_integer_round_trip<unsigned long long>();
+
+	// the shortest form, with std::to_chars in C++17 and with snprintf and strtod in C++14
+	const double doubles[] = { 0.1, 1.0 / 3, 5e-324, 2.2250738585072014e-308, std::numeric_limits<double>::max(), -1e21, 123456789012345680.0, 0.5 };
+	for (size_t i = 0; i != sizeof(doubles) / sizeof(doubles[0]); i++) check_float_round_trip(doubles[i]);
+	const float floats[] = { 0.1f, 1.0f / 3, 1e-45f, std::numeric_limits<float>::max(), -16777217.0f, 3.14159265f };
+	for (size_t i = 0; i != sizeof(floats) / sizeof(floats[0]); i++) check_float_round_trip(floats[i]);
+	for (int i = 0; i != 3000; i++)
+	{
+		const uint64_t bits = static_cast<uint64_t>(rand()) << 42 ^ static_cast<uint64_t>(rand()) << 21 ^ static_cast<uint64_t>(rand());
+		double as_double;
+		memcpy(&as_double, &bits, sizeof(as_double));
+		if (as_double == as_double && as_double - as_double == 0) check_float_round_trip(as_double); // neither nan nor infinite
+		const uint32_t low = static_cast<uint32_t>(bits);
+		float as_float;
+		memcpy(&as_float, &low, sizeof(as_float));
+		if (as_float == as_float && as_float - as_float == 0) check_float_round_trip(as_float);
+	}
+}
+
+inline void test_number_grammar()
+{
+	// the same with std::from_chars and with strtod
+	double value = 5;
+	const char* const plus = "+1";
+	CHECK(from_chars(plus, plus + 2, value) == nullptr && value == 5);
+	const char* const hex = "-0x10";
+	CHECK(from_chars(hex, hex + 5, value) == hex + 2 && value == 0);
+	const char* const huge = "1e99999";
+	CHECK(from_chars(huge, huge + 7, value) == nullptr && value == 0);
+	const char* const subnormal = "5e-324";
+	CHECK(from_chars(subnormal, subnormal + 6, value) == subnormal + 6 && value > 0);
+
+	// a number longer than the buffer of strtod is not cut short
+	const std::string long_number = "1" + std::string(199, '0');
+	value = 5;
+	const char* const end = from_chars(long_number.data(), long_number.data() + long_number.size(), value);
+#ifdef TVJ_NUMBER_STD_CHARCONV
+	CHECK(end == long_number.data() + long_number.size() && value == 1e199);
+#else
+	CHECK(end == nullptr && value == 5);
+#endif
+}
+
+inline void test_bulk_builders()
+{
+	vector<int> level;
+	level.push_back(1);
+	for (int i = 0; i != 4; i++) level.push_back(-1);
+	checked_tree single;
+	single.build_from_level_order(level, -1);
+	CHECK(single.size() == 1 && single.at(0) == 1);
+	level[0] = -1;
+	single.build_from_level_order(level, -1);
+	CHECK(single.size() == 0);
+
+	for (unsigned seed = 1; seed <= 10; seed++)
+	{
+		checked_tree tree;
+		grow_random(tree, seed * 29, seed);
+		const vector<int> pre__ = tree.sequence(0), in__ = tree.sequence(1), post__ = tree.sequence(2);
+
+		checked_tree from_pre;
+		from_pre.build_from_preorder(pre__, in__);
+		CHECK(from_pre.sequence(0) == pre__ && from_pre.sequence(1) == in__ && from_pre.sequence(2) == post__);
+		check_against_sequences(from_pre);
+
+		checked_tree from_post;
+		from_post.build_from_postorder(post__, in__);
+		CHECK(from_post.sequence(0) == pre__ && from_post.sequence(1) == in__ && from_post.sequence(2) == post__);
+
+		// the level order with -1 for a missing child
+		vector<int> level__;
+		std::vector<binary_tree<int>::const_iterator> queue__;
+		queue__.push_back(tree.croot());
+		level__.push_back(*tree.croot());
+		for (size_t head = 0; head != queue__.size(); head++)
+		{
+			const auto node__ = queue__[head];
+			level__.push_back(node__.has_left_child() ? *node__.left_child() : -1);
+			if (node__.has_left_child()) queue__.push_back(node__.left_child());
+			level__.push_back(node__.has_right_child() ? *node__.right_child() : -1);
+			if (node__.has_right_child()) queue__.push_back(node__.right_child());
+		}
+		checked_tree from_level;
+		from_level.build_from_level_order(level__, -1);
+		CHECK(from_level.sequence(0) == pre__ && from_level.sequence(1) == in__ && from_level.sequence(2) == post__);
+
+		// extra null markers at the end are ignored, but not an element after them
+		for (int i = 0; i != 5; i++) level__.push_back(-1);
+		from_level.build_from_level_order(level__, -1);
+		CHECK(from_level.sequence(1) == in__);
+		level__.push_back(static_cast<int>(seed));
+		bool thrown__ = false;
+		try { from_level.build_from_level_order(level__, -1); } catch (const std::invalid_argument&) { thrown__ = true; }
+		CHECK(thrown__ && from_level.size() == 0);
+
+		vector<int> sorted__;
+		for (int i = 0; i != static_cast<int>(seed * 29); i++) sorted__.push_back(i);
+		checked_tree balanced;
+		balanced.build_balanced(sorted__);
+		CHECK(balanced.sequence(1) == sorted__);
+		check_against_sequences(balanced);
+	}
+}
+
+int main()
+{
+	test_binary_tree();
+	test_stacks();
+	test_node_pool();
+	test_freeze();
+	test_compact_self_insertion();
+	test_rope();
+	test_search();
+	test_utf8_validate();
+	test_split();
+	test_string_concat();
+	test_string_builder();
+	test_string_io();
+	test_hash_and_interner();
+	test_huffman_decode();
+	test_concurrent();
+	test_text_index_load();
+	test_text_index_search();
+	test_long_double();
+	test_number_round_trip();
+	test_number_grammar();
+	test_bulk_builders();
+
+	std::cout << (failures ? "Some checks failed." : "All checks passed.") << std::endl;
+	return failures;
+}